@@ -0,0 +1,202 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include <camera.h>
+#include <shader.h>
+#include <gl_objects.h>
+#include <shader_library.h>
+#include <frame_data.h>
+#include <program_cache.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+// settings
+constexpr unsigned int DRAWS_PER_FRAME = 10000;
+constexpr unsigned int FRAMES = 20;
+
+// per-object values; they differ from one draw to the next like they would for real objects, so the shadow copy
+// can't skip them and every pass below uploads the same amount
+// ---------------------------------------------------------------------------------------------------------------------
+glm::mat4 modelFor(const unsigned int draw) {
+    return glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(draw), 0.0f, 0.0f));
+}
+
+glm::vec3 colorFor(const unsigned int draw) {
+    return glm::vec3(1.0f, 1.0f, static_cast<float>(draw) / static_cast<float>(DRAWS_PER_FRAME));
+}
+
+// the uniform setter sequence the material apps issue for every object
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename Vec3Setter, typename FloatSetter, typename Mat4Setter>
+void setMaterialUniforms(Vec3Setter setVec3, FloatSetter setFloat, Mat4Setter setMat4, const unsigned int draw) {
+    setVec3("light.position", glm::vec3(1.2f, 1.0f, 2.0f));
+    setVec3("light.ambient", glm::vec3(0.2f));
+    setVec3("light.diffuse", glm::vec3(0.5f));
+    setVec3("light.specular", glm::vec3(1.0f));
+    setFloat("material.shininess", 64.0f);
+    setVec3("material.color", colorFor(draw));
+    setFloat("material.tintStrength", 1.0f);
+    setFloat("material.emissionStrength", 1.0f);
+    setMat4("model", modelFor(draw));
+}
+
+// runs FRAMES frames of DRAWS_PER_FRAME draws and returns the average frame time in milliseconds
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename Frame>
+double timeFrames(Frame frame) {
+    // warm up once so driver-side shader variants are already built
+    frame();
+    glFinish();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < FRAMES; i++)
+        frame();
+    glFinish();
+    const auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / FRAMES;
+}
+
+int main() {
+
+    // glfw initialise; the benchmark renders into a hidden window
+    // ---------------------------------------------------------------
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(64, 64, "Uniform Setter Benchmark", nullptr, nullptr);
+    if (!window) {
+        std::cout << "Failed to create GLFW window" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    // load glad
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cout << "Failed to initialize GLAD" << std::endl;
+        glfwTerminate();
+        glfwDestroyWindow(window);
+        return -1;
+    }
+
+    // the full material permutation, so every uniform below is active
+    const Shader lightingShader("resources/shaders/material.vert", "resources/shaders/material.frag", ShaderBuild::Blocking,
+                                ShaderLibrary::definesFor({HAS_TINT, HAS_SPECULAR, HAS_EMISSION}));
+
+    // attribute-less draws, the benchmark only cares about CPU-side submission cost
+    const VertexArray emptyVAO;
+    emptyVAO.bind();
+
+    // camera matrices live in the FrameData block, uploaded once rather than per draw
+    FrameUniforms frameUniforms;
+    frameUniforms.update(Camera{glm::vec3(0.0f, 0.0f, 3.0f)}, 1.0f, 0.0f);
+
+    lightingShader.use();
+
+    // the material uniforms live in the fragment stage, model in the shared vertex stage
+    const GLuint vertexProgram = lightingShader.getStageProgram(GL_VERTEX_SHADER);
+    const GLuint fragmentProgram = lightingShader.getStageProgram(GL_FRAGMENT_SHADER);
+
+    // before: a std::string and a glGetUniformLocation round trip per setter call
+    const double uncachedMs = timeFrames([&] {
+        for (unsigned int i = 0; i < DRAWS_PER_FRAME; i++) {
+            setMaterialUniforms(
+                [&](const std::string_view name, const glm::vec3& v) {
+                    glProgramUniform3fv(fragmentProgram, glGetUniformLocation(fragmentProgram, std::string(name).c_str()), 1, &v[0]);
+                },
+                [&](const std::string_view name, const float f) {
+                    glProgramUniform1f(fragmentProgram, glGetUniformLocation(fragmentProgram, std::string(name).c_str()), f);
+                },
+                [&](const std::string_view name, const glm::mat4& m) {
+                    glProgramUniformMatrix4fv(vertexProgram, glGetUniformLocation(vertexProgram, std::string(name).c_str()), 1, GL_FALSE, &m[0][0]);
+                },
+                i);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+        }
+    });
+
+    // after: locations come from the table built at link time, and unchanged values never reach the driver
+    UniformTable::takeUploadStats();
+    const double cachedMs = timeFrames([&] {
+        for (unsigned int i = 0; i < DRAWS_PER_FRAME; i++) {
+            setMaterialUniforms(
+                [&](const std::string_view name, const glm::vec3& v) { lightingShader.setVec3(name, v); },
+                [&](const std::string_view name, const float f) { lightingShader.setFloat(name, f); },
+                [&](const std::string_view name, const glm::mat4& m) { lightingShader.setMat4(name, m); },
+                i);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+        }
+    });
+
+    const UniformUploadStats cachedUploads = UniformTable::takeUploadStats();
+
+    // pre-resolved handles: no lookup at all, at most one glProgramUniform* per set
+    const auto uLightPosition = lightingShader.uniform<glm::vec3>("light.position");
+    const auto uLightAmbient = lightingShader.uniform<glm::vec3>("light.ambient");
+    const auto uLightDiffuse = lightingShader.uniform<glm::vec3>("light.diffuse");
+    const auto uLightSpecular = lightingShader.uniform<glm::vec3>("light.specular");
+    const auto uShininess = lightingShader.uniform<float>("material.shininess");
+    const auto uColor = lightingShader.uniform<glm::vec3>("material.color");
+    const auto uTintStrength = lightingShader.uniform<float>("material.tintStrength");
+    const auto uEmissionStrength = lightingShader.uniform<float>("material.emissionStrength");
+    const auto uModel = lightingShader.uniform<glm::mat4>("model");
+
+    // varying: the per-object values change every draw; constant: every draw looks like the first, which is what the
+    // shadow copy saves when objects share a material
+    const auto handleFrame = [&](const bool varying) {
+        for (unsigned int i = 0; i < DRAWS_PER_FRAME; i++) {
+            const unsigned int draw = varying ? i : 0;
+            uLightPosition.set(glm::vec3(1.2f, 1.0f, 2.0f));
+            uLightAmbient.set(glm::vec3(0.2f));
+            uLightDiffuse.set(glm::vec3(0.5f));
+            uLightSpecular.set(glm::vec3(1.0f));
+            uShininess.set(64.0f);
+            uColor.set(colorFor(draw));
+            uTintStrength.set(1.0f);
+            uEmissionStrength.set(1.0f);
+            uModel.set(modelFor(draw));
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+        }
+    };
+
+    const double handleMs = timeFrames([&] { handleFrame(true); });
+    const UniformUploadStats handleUploads = UniformTable::takeUploadStats();
+
+    const double constantMs = timeFrames([&] { handleFrame(false); });
+    const UniformUploadStats constantUploads = UniformTable::takeUploadStats();
+
+    // run twice to see the program binary cache kick in (also works on Mesa with LIBGL_ALWAYS_SOFTWARE=1)
+    const ProgramCacheStats& cacheStats = ProgramBinaryCache::getStats();
+    std::cout << "Program binary cache: " << cacheStats.hits << " hits, " << cacheStats.misses << " misses ("
+              << cacheStats.rejected << " rejected), " << cacheStats.savedMs << " ms saved\n";
+
+    std::cout << "Uniform setters, " << DRAWS_PER_FRAME << " draws/frame, "
+              << lightingShader.getUniformCount() << " cached uniforms\n"
+              << "  glGetUniformLocation per call: " << uncachedMs << " ms/frame\n"
+              << "  link-time location cache:      " << cachedMs << " ms/frame\n"
+              << "  pre-resolved Uniform<T>:       " << handleMs << " ms/frame\n"
+              << "  speed-up (cache / handles):    " << uncachedMs / cachedMs << "x / " << uncachedMs / handleMs << "x\n"
+              << "  shadowed uploads (cache):      " << cachedUploads.uploads << " uploaded, " << cachedUploads.skipped << " skipped\n"
+              << "  shadowed uploads (handles):    " << handleUploads.uploads << " uploaded, " << handleUploads.skipped << " skipped\n"
+              << "  constant values, Uniform<T>:   " << constantMs << " ms/frame, " << constantUploads.uploads << " uploaded, "
+              << constantUploads.skipped << " skipped (" << handleMs / constantMs << "x from the shadow copy)" << std::endl;
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+
+    return 0;
+}
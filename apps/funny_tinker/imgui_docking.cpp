@@ -4,22 +4,61 @@
 
 #include <camera.h>
 #include <shader.h>
+#include <gl_objects.h>
+#include <mesh_library.h>
+#include <gl_state.h>
+#include <shader_library.h>
+#include <frame_data.h>
+#include <shader_watcher.h>
+#include <program_cache.h>
 
 #include <iostream>
 #include <ostream>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
-#include <stb_image.h>
 
 #include "imgui.h"
 #include "backends/imgui_impl_glfw.h"
 #include "backends/imgui_impl_opengl3.h"
 
+// uniforms of the material program, resolved once it has finished building and again after every reload
+// ---------------------------------------------------------------------------
+struct MaterialUniforms {
+    unsigned int generation = 0; // generation of the program the handles below belong to
+
+    Uniform<glm::vec3> lightPosition;
+    Uniform<glm::vec3> lightAmbient;
+    Uniform<glm::vec3> lightDiffuse;
+    Uniform<glm::vec3> lightSpecular;
+    Uniform<float> shininess;
+    Uniform<glm::vec3> color;
+    Uniform<float> tintStrength;
+    Uniform<float> emissionStrength;
+    Uniform<glm::mat4> model;
+
+    void resolve(const Shader& shader) {
+        shader.use();
+        shader.setInt("material.diffuse", 0);
+        shader.setInt("material.specular", 1);
+        shader.setInt("material.emission", 2);
+
+        lightPosition = shader.uniform<glm::vec3>("light.position");
+        lightAmbient = shader.uniform<glm::vec3>("light.ambient");
+        lightDiffuse = shader.uniform<glm::vec3>("light.diffuse");
+        lightSpecular = shader.uniform<glm::vec3>("light.specular");
+        shininess = shader.uniform<float>("material.shininess");
+        color = shader.uniform<glm::vec3>("material.color");
+        tintStrength = shader.uniform<float>("material.tintStrength");
+        emissionStrength = shader.uniform<float>("material.emissionStrength");
+        model = shader.uniform<glm::mat4>("model");
+        generation = shader.getGeneration();
+    }
+};
+
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void mouse_callback(GLFWwindow* window, double xPosIn, double yPosIn);
 void processInput(GLFWwindow* window);
-unsigned int loadTexture(const char* path);
 
 void setupImGUIDocking();
 void renderImGUIWindows(unsigned int texture_color_buffer);
@@ -61,9 +100,18 @@ float lightAmbient[3] = { 0.2f, 0.2f, 0.2f };
 float lightDiffuse[3] = { 0.5f, 0.5f, 0.5f };
 
 // rendering flags
+// uniform uploads, state changes and mesh traffic of the previous frame, shown in the statistics window
+UniformUploadStats uniformUploads;
+GLStateStats stateChanges;
+MeshMemoryStats meshMemory;
+MeshDrawStats meshDraws;
+
 bool showDemoWindow = false;
 bool showCube = true;
 bool showLight = true;
+bool compactVertices = true;
+// set by the statistics window, handled outside the UI pass
+bool compactMeshes = false;
 
 int main() {
 
@@ -120,137 +168,59 @@ int main() {
 
     // configure global open gl state
     // ------------------------------
-    glEnable(GL_DEPTH_TEST);
-
-    // build and compile the shader program
-    const Shader lightingShader("resources/shaders/material.vert", "resources/shaders/material.frag");
-    const Shader lightCubeShader("resources/shaders/lighting/lighting_cube.vert", "resources/shaders/lighting/lighting_cube.frag");
-
-    // set up cube vertices
-    constexpr float vertices[] = {
-        // positions          // normals           // texture coords
-        -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  0.0f,
-         0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  0.0f,
-         0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  1.0f,
-         0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  1.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  1.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  0.0f,
-
-        -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  0.0f,
-         0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  0.0f,
-         0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  1.0f,
-         0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  1.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  1.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  0.0f,
-
-        -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-        -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  1.0f,
-        -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-        -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-        -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  0.0f,
-        -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-
-         0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-         0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  1.0f,
-         0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-         0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-         0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  0.0f,
-         0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-
-        -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  1.0f,
-         0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  1.0f,
-         0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  0.0f,
-         0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  0.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  0.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  1.0f,
-
-        -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  1.0f,
-         0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  1.0f,
-         0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  0.0f,
-         0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  0.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  0.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  1.0f
-    };
-
-    // configure cube VAO and VBO
-    unsigned int VBO, cubeVAO;
-    glGenVertexArrays(1, &cubeVAO);
-    glGenBuffers(1, &VBO);
+    GLState::enable(GL_DEPTH_TEST);
 
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    // build and compile the shader programs; the material program keeps compiling in the background
+    // while the rest of the app starts up, the light cube program doubles as its stand-in until then
+    Shader::enableParallelCompile();
 
-    glBindVertexArray(cubeVAO);
+    // rebuild programs whenever one of their source files is saved
+    ShaderWatcher shaderWatcher;
 
-    // position attributes
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), static_cast<void *>(nullptr));
-    glEnableVertexAttribArray(0);
-    // normal attribute
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), reinterpret_cast<void *>(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    // tex coords
-    // diffuse
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), reinterpret_cast<void *>(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+    // the material program is built as the permutation this scene needs, and watched like the rest
+    ShaderLibrary shaderLibrary(&shaderWatcher);
+    shaderLibrary.add("material", "resources/shaders/material.vert", "resources/shaders/material.frag");
+    Shader& lightingShader = *shaderLibrary.get("material", {HAS_TINT, HAS_SPECULAR, HAS_EMISSION});
 
-    // specular
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), reinterpret_cast<void *>(6 * sizeof(float)));
-    glEnableVertexAttribArray(3);
+    Shader lightCubeShader("resources/shaders/lighting/lighting_cube.vert", "resources/shaders/lighting/lighting_cube.frag");
+    shaderWatcher.watch(lightCubeShader);
 
-    // emission
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), reinterpret_cast<void *>(6 * sizeof(float)));
-    glEnableVertexAttribArray(4);
+    // per-frame camera data shared by every program
+    FrameUniforms frameUniforms;
 
-    // configure light VAO
-    unsigned int lightCubeVAO;
-    glGenVertexArrays(1, &lightCubeVAO);
-    glBindVertexArray(lightCubeVAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), static_cast<void *>(nullptr));
-    glEnableVertexAttribArray(0);
+    // shared indexed primitives; the lit cube can switch to the 16-byte quantized copy to compare vertex formats
+    MeshLibrary meshLibrary;
+    const Mesh& cube = *meshLibrary.get("cube");
+    const Mesh& compactCube = meshLibrary.add("compact_cube", primitives::cube(), VertexFormat::compact());
 
     // load textures
     // ---------------
-    const unsigned int diffuseMap = loadTexture("resources/textures/container2.png");
-    const unsigned int specularMap = loadTexture("resources/textures/container2_specular.png");
-    const unsigned int emissionMap = loadTexture("resources/textures/matrix.jpg");
+    const Texture diffuseMap = Texture::load("resources/textures/container2.png");
+    const Texture specularMap = Texture::load("resources/textures/container2_specular.png");
+    const Texture emissionMap = Texture::load("resources/textures/matrix.jpg");
 
-    // shader config
+    // shader config; the material program is configured once it has finished building
     // ---------------
-    lightingShader.use();
-    lightingShader.setInt("material.diffuse", 0);
-    lightingShader.setInt("material.specular", 1);
-    lightingShader.setInt("material.emission", 2);
+    MaterialUniforms materialUniforms;
 
     // custom framebuffer for scene rendering
     // ----------------------------------------
-    unsigned int frameBuffer;
-    glGenFramebuffers(1, &frameBuffer);
-    glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
+    const Framebuffer frameBuffer;
 
     // color attachment texture
     // ----------------------------------------
-    unsigned int textureColorBuffer;
-    glGenTextures(1, &textureColorBuffer);
-    glBindTexture(GL_TEXTURE_2D, textureColorBuffer);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, textureColorBuffer, 0);
+    const Texture textureColorBuffer(SCR_WIDTH, SCR_HEIGHT, GL_RGB8);
+    textureColorBuffer.setParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    textureColorBuffer.setParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    frameBuffer.attach(GL_COLOR_ATTACHMENT0, textureColorBuffer);
 
     // renderbuffer for depth and stencil
     // ---------------------------------
-    unsigned int rbo;
-    glGenRenderbuffers(1, &rbo);
-    glBindRenderbuffer(GL_RENDERBUFFER, rbo);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, SCR_WIDTH, SCR_HEIGHT);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rbo);
+    const Renderbuffer rbo(GL_DEPTH24_STENCIL8, SCR_WIDTH, SCR_HEIGHT);
+    frameBuffer.attach(GL_DEPTH_STENCIL_ATTACHMENT, rbo);
 
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    if (!frameBuffer.complete())
         std::cout << "ERROR::FRAMEBUFFER::FRAMEBUFFER is not complete!" << std::endl;
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
     // render loop
     // -----------------
@@ -266,84 +236,84 @@ int main() {
         // -----
         processInput(window);
 
+        // shader hot-reload, only does work when a watched file changed
+        shaderWatcher.poll();
+
+        uniformUploads = UniformTable::takeUploadStats();
+        stateChanges = GLState::takeStats();
+        meshDraws = meshLibrary.takeDrawStats();
+        if (compactMeshes) {
+            meshLibrary.compact();
+            compactMeshes = false;
+        }
+        meshMemory = meshLibrary.getMemoryStats();
+
         // render
         // ------
-        glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
+        frameBuffer.bind();
         glClearColor(backgroundColor[0], backgroundColor[1], backgroundColor[2], 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        if (showCube) {
+        // view/projection transformations, uploaded once for every program
+        frameUniforms.update(camera, static_cast<float>(SCR_WIDTH) / static_cast<float>(SCR_HEIGHT), currentFrame);
+
+        if (showCube && lightingShader.ready()) {
+            // first frame the material program is available, or after a hot-reload: bind its samplers and resolve its uniforms
+            if (materialUniforms.generation != lightingShader.getGeneration())
+                materialUniforms.resolve(lightingShader);
+
             // be sure to activate shader when setting uniforms/drawing objects
             lightingShader.use();
-            lightingShader.setVec3("light.position", lightPos);
-            lightingShader.setVec3("viewPos", camera.Position);
-            lightingShader.setVec3("light.specular", lightColorValues[0], lightColorValues[1], lightColorValues[2]);
+            materialUniforms.lightPosition.set(lightPos);
+            materialUniforms.lightSpecular.set(glm::vec3(lightColorValues[0], lightColorValues[1], lightColorValues[2]));
 
             // light properties
             if (autoTintLighting) {
-                lightingShader.setVec3("light.ambient",
+                materialUniforms.lightAmbient.set(glm::vec3(
                     lightAmbient[0] * lightColorValues[0],
                     lightAmbient[1] * lightColorValues[1],
                     lightAmbient[2] * lightColorValues[2]
-                );
-                lightingShader.setVec3("light.diffuse",
+                ));
+                materialUniforms.lightDiffuse.set(glm::vec3(
                     lightDiffuse[0] * lightColorValues[0],
                     lightDiffuse[1] * lightColorValues[1],
-                    lightDiffuse[2] * lightColorValues[2]);
+                    lightDiffuse[2] * lightColorValues[2]));
             }
             else {
-                lightingShader.setVec3("light.ambient", lightAmbient[0], lightAmbient[1], lightAmbient[2]);
-                lightingShader.setVec3("light.diffuse", lightDiffuse[0], lightDiffuse[1], lightDiffuse[2]);
+                materialUniforms.lightAmbient.set(glm::vec3(lightAmbient[0], lightAmbient[1], lightAmbient[2]));
+                materialUniforms.lightDiffuse.set(glm::vec3(lightDiffuse[0], lightDiffuse[1], lightDiffuse[2]));
             }
 
             // material properties
-            lightingShader.setFloat("material.shininess", shininess);
-            lightingShader.setVec3("material.color", glm::vec3(color[0], color[1], color[2]));
-            lightingShader.setFloat("material.tintStrength", tintStrength);
-            lightingShader.setFloat("material.emissionStrength", emissionStrength);
-
-            // view/projection transformations
-            glm::mat4 projection = glm::perspective(
-                glm::radians(camera.Zoom),
-                static_cast<float>(SCR_WIDTH) / static_cast<float>(SCR_HEIGHT),
-                0.1f,
-                100.0f
-            );
-            glm::mat4 view = camera.GetViewMatrix();
-
-            lightingShader.setMat4("projection", projection);
-            lightingShader.setMat4("view", view);
+            materialUniforms.shininess.set(shininess);
+            materialUniforms.color.set(glm::vec3(color[0], color[1], color[2]));
+            materialUniforms.tintStrength.set(tintStrength);
+            materialUniforms.emissionStrength.set(emissionStrength);
 
             // world transformation
             auto model = glm::mat4(1.0f);
-            lightingShader.setMat4("model", model);
+            materialUniforms.model.set(model);
 
-            // bind diffuse map
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, diffuseMap);
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, specularMap);
-            glActiveTexture(GL_TEXTURE2);
-            glBindTexture(GL_TEXTURE_2D, emissionMap);
+            // bind the material maps
+            diffuseMap.bind(0);
+            specularMap.bind(1);
+            emissionMap.bind(2);
 
             // render the cube
-            glBindVertexArray(cubeVAO);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
+            meshLibrary.draw(compactVertices ? compactCube : cube, lightingShader);
         }
+        else if (showCube) {
+            // material program still compiling, stand in with a flat cube
+            lightCubeShader.use();
+            lightCubeShader.setVec3("lightColor", glm::vec3(color[0], color[1], color[2]));
+            lightCubeShader.setMat4("model", glm::mat4(1.0f));
 
-        if (showLight) {
-            glm::mat4 projection = glm::perspective(
-                glm::radians(camera.Zoom),
-                static_cast<float>(SCR_WIDTH) / static_cast<float>(SCR_HEIGHT),
-                0.1f,
-                100.0f
-            );
-            glm::mat4 view = camera.GetViewMatrix();
+            meshLibrary.draw(cube, lightCubeShader);
+        }
 
+        if (showLight) {
             // also draw the lamp object
             lightCubeShader.use();
-            lightCubeShader.setMat4("projection", projection);
-            lightCubeShader.setMat4("view", view);
             lightCubeShader.setVec3("lightColor", glm::vec3(lightColorValues[0], lightColorValues[1], lightColorValues[2]));
 
             auto model = glm::mat4(1.0f);
@@ -351,11 +321,10 @@ int main() {
             model = scale(model, glm::vec3(0.2f)); // a smaller cube
             lightCubeShader.setMat4("model", model);
 
-            glBindVertexArray(lightCubeVAO);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
+            meshLibrary.draw(cube, lightCubeShader);
         }
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 
         // imgui: initialise
         // ----------------------------
@@ -366,7 +335,7 @@ int main() {
         // imgui: setup docking environment
         // --------------------------------
         setupImGUIDocking();
-        renderImGUIWindows(textureColorBuffer);
+        renderImGUIWindows(textureColorBuffer.id());
 
         // show demo window
         if (showDemoWindow)
@@ -377,6 +346,9 @@ int main() {
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
+        // the ImGui backend binds its own program, buffers and textures; don't trust the mirror past this point
+        GLState::invalidate();
+
         // imgui: update and render
         if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
             GLFWwindow* backup_current_context = glfwGetCurrentContext();
@@ -396,12 +368,6 @@ int main() {
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
 
-    glDeleteVertexArrays(1, &cubeVAO);
-    glDeleteVertexArrays(1, &lightCubeVAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteFramebuffers(1, &frameBuffer);
-    glDeleteTextures(1, &textureColorBuffer);
-    glDeleteRenderbuffers(1, &rbo);
 
     glfwDestroyWindow(window);
     glfwTerminate();
@@ -486,44 +452,6 @@ void mouse_callback(GLFWwindow*, const double xPosIn, const double yPosIn) {
     camera.ProcessMouseMovement(xOffset, yOffset);
 }
 
-// utility function for loading a 2D texture from file
-// ---------------------------------------------------
-unsigned int loadTexture(char const * path)
-{
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-
-    int width, height, nrComponents;
-    if (unsigned char *data = stbi_load(path, &width, &height, &nrComponents, 0))
-    {
-        GLenum format = 0;
-        if (nrComponents == 1)
-            format = GL_RED;
-        else if (nrComponents == 3)
-            format = GL_RGB;
-        else if (nrComponents == 4)
-            format = GL_RGBA;
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, static_cast<int>(format), width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-    }
-    else
-    {
-        std::cout << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
-    }
-
-    return textureID;
-}
-
 // imgui: setting up all the necessary docking properties
 // -------------------------------------------------------
 void setupImGUIDocking() {
@@ -685,6 +613,26 @@ void renderImGUIWindows(const unsigned int texture_color_buffer) {
     ImGui::Begin("Statistics");
     ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
     ImGui::Text("Camera Position: (%.2f, %.2f, %.2f)", camera.Position.x, camera.Position.y, camera.Position.z);
+
+    const ProgramCacheStats& cacheStats = ProgramBinaryCache::getStats();
+    ImGui::Text("Program cache: %u hits, %u misses, %.1f ms saved", cacheStats.hits, cacheStats.misses, cacheStats.savedMs);
+    ImGui::Text("Uniforms: %u uploaded, %u skipped per frame", uniformUploads.uploads, uniformUploads.skipped);
+    ImGui::Text("Shader stages: %zu compiled", ShaderStage::getLiveCount());
+    ImGui::Text("GL state: %u calls forwarded, %u avoided per frame", stateChanges.forwarded, stateChanges.avoided);
+    ImGui::Text("GL calls: %u per frame, %u of them draws", stateChanges.forwarded + uniformUploads.uploads + stateChanges.draws,
+        stateChanges.draws);
+
+    ImGui::Checkbox("Compact vertices", &compactVertices);
+    ImGui::Text("Mesh memory: %.1f KB vertices (%.1f KB as floats), %.1f KB indices",
+        static_cast<float>(meshMemory.vertexBytes) / 1024.0f, static_cast<float>(meshMemory.floatVertexBytes) / 1024.0f,
+        static_cast<float>(meshMemory.indexBytes) / 1024.0f);
+    ImGui::Text("Mesh arenas: %.1f KB reserved, %.0f%% fragmented",
+        static_cast<float>(meshMemory.arenaBytes) / 1024.0f, meshMemory.fragmentation * 100.0f);
+    ImGui::SameLine();
+    if (ImGui::Button("Compact"))
+        compactMeshes = true;
+    ImGui::Text("Vertex fetch: %zu bytes (%zu as floats) in %u draws per frame",
+        meshDraws.fetchedBytes, meshDraws.floatFetchedBytes, meshDraws.draws);
     ImGui::End();
 
     // Controls Window
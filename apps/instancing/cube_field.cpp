@@ -0,0 +1,434 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include <camera.h>
+#include <shader.h>
+#include <gl_objects.h>
+#include <mesh_library.h>
+#include <mesh_lod.h>
+#include <draw_list.h>
+#include <object_buffer.h>
+#include <primitive_generator.h>
+#include <gl_state.h>
+#include <shader_library.h>
+#include <frame_data.h>
+#include <shader_watcher.h>
+#include <thread_pool.h>
+
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+void framebuffer_size_callback(GLFWwindow* window, int width, int height);
+void mouse_callback(GLFWwindow* window, double xPosIn, double yPosIn);
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
+void processInput(GLFWwindow* window);
+
+// settings
+constexpr unsigned int SCR_WIDTH = 1280;
+constexpr unsigned int SCR_HEIGHT = 720;
+int lastAltState = GLFW_RELEASE;
+int lastRenderPathState = GLFW_RELEASE;
+int lastLodState = GLFW_RELEASE;
+float viewportHeight = SCR_HEIGHT;
+
+// scene: a 25 x 16 x 25 block of randomly turned container cubes, spheres, quantized cubes and tori
+constexpr int FIELD_WIDTH = 25;
+constexpr int FIELD_HEIGHT = 16;
+constexpr int FIELD_DEPTH = 25;
+constexpr int CUBE_COUNT = FIELD_WIDTH * FIELD_HEIGHT * FIELD_DEPTH;
+constexpr float CUBE_SPACING = 2.0f;
+
+// I cycles through the ways of submitting the same scene
+enum class RenderPath {
+    Instanced,  // one instanced draw per mesh
+    MultiDraw,  // one multi-draw per vertex format
+    PerObject,  // a draw per object, reading its ObjectData by baseInstance
+};
+RenderPath renderPath = RenderPath::MultiDraw;
+
+// L toggles the sphere detail levels in the multi-draw and per-object paths; instancing always draws level 0
+bool useLod = true;
+
+// Camera
+Camera camera{
+    glm::vec3(0.0f, 0.0f, 55.0f)
+};
+float lastX = SCR_WIDTH / 2.0f;
+float lastY = SCR_HEIGHT / 2.0f;
+bool firstMouse = false;
+bool isCursorLocked = true;
+
+// timing
+float deltaTime = 0.0f;
+float lastFrame = 0.0f;
+
+// lighting
+glm::vec3 lightPos(0.0f, 25.0f, 35.0f);
+
+int main() {
+
+    // glfw initialise
+    // ---------------------
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    // glfw init window
+    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Cube Field", nullptr, nullptr);
+    if (!window) {
+        std::cout << "Failed to create GLFW window" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetCursorPosCallback(window, mouse_callback);
+    glfwSetScrollCallback(window, scroll_callback);
+
+    // tell glfw to capture our mouse, and don't wait for vsync so the frame time shows the submission cost
+    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    glfwSwapInterval(0);
+
+    // load glad
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cout << "Failed to initialize GLAD" << std::endl;
+        glfwTerminate();
+        glfwDestroyWindow(window);
+        return -1;
+    }
+
+    // configure global open gl state
+    // ------------------------------
+    GLState::enable(GL_DEPTH_TEST);
+
+    // build and compile the shader programs
+    Shader::enableParallelCompile();
+    Shader lightCubeShader("resources/shaders/lighting/lighting_cube.vert", "resources/shaders/lighting/lighting_cube.frag");
+
+    ShaderWatcher shaderWatcher;
+    shaderWatcher.watch(lightCubeShader);
+
+    // all permutations share the fragment stage, INSTANCED, MULTI_DRAW and OBJECT_DATA only change the vertex stage
+    ShaderLibrary shaderLibrary(&shaderWatcher);
+    shaderLibrary.add("material", "resources/shaders/material.vert", "resources/shaders/material.frag", ShaderBuild::Blocking);
+    Shader& instancedShader = *shaderLibrary.get("material", {HAS_SPECULAR, INSTANCED});
+    Shader& multiDrawShader = *shaderLibrary.get("material", {HAS_SPECULAR, INSTANCED, MULTI_DRAW});
+    Shader& objectShader = *shaderLibrary.get("material", {HAS_SPECULAR, OBJECT_DATA});
+
+    // per-frame camera data shared by every program
+    FrameUniforms frameUniforms;
+
+    MeshLibrary meshLibrary;
+    const Mesh& cube = *meshLibrary.get("cube");
+
+    // a sphere dense enough that the far side of the field gains from fewer triangles
+    ThreadPool pool;
+    const LodMesh sphereLod = addLodMesh(meshLibrary, pool, "dense_sphere", procedural::generate(PrimitiveDesc::sphere(128, 64)));
+    std::cout << "dense_sphere LODs:";
+    for (const MeshLod& level : sphereLod.levels)
+        std::cout << ' ' << level.triangles << " (" << level.error << ')';
+    std::cout << std::endl;
+    LodSelector lodSelector;
+
+    // generated once; asking again for the same torus anywhere else returns this mesh
+    PrimitiveCache primitiveCache(meshLibrary);
+    const Mesh& torus = primitiveCache.get(PrimitiveDesc::torus(64, 24), VertexFormat::compact());
+    const PrimitiveCacheStats& primitiveStats = primitiveCache.getStats();
+    std::cout << "torus generated in " << primitiveStats.generateMs << " ms, uploaded in " << primitiveStats.uploadMs
+              << " ms" << std::endl;
+
+    const std::array<const Mesh*, 4> meshes = {
+        &cube,
+        sphereLod.levels[0].mesh,
+        &meshLibrary.add("compact_cube", primitives::cube(), VertexFormat::compact()),
+        &torus,
+    };
+
+    DrawList drawList(meshLibrary);
+    ObjectBuffer objectBuffer(CUBE_COUNT);
+
+    // objects, generated once; every render path reads the same placements
+    // ----------------------------------------------------------------------
+    struct Object {
+        const Mesh* mesh;
+        InstanceTransform transform;
+        std::uint32_t objectIndex;
+        std::uint8_t lodLevel = 0;
+    };
+    std::vector<Object> objects;
+    objects.reserve(CUBE_COUNT);
+
+    std::mt19937 random(1337);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> scales(0.6f, 1.2f);
+
+    const glm::vec3 fieldCentre = 0.5f * CUBE_SPACING * glm::vec3(FIELD_WIDTH - 1, FIELD_HEIGHT - 1, FIELD_DEPTH - 1);
+    for (int x = 0; x < FIELD_WIDTH; x++) {
+        for (int y = 0; y < FIELD_HEIGHT; y++) {
+            for (int z = 0; z < FIELD_DEPTH; z++) {
+                const glm::vec3 position = CUBE_SPACING * glm::vec3(x, y, z) - fieldCentre;
+                const glm::quat rotation = glm::angleAxis(unit(random) * glm::pi<float>(),
+                                                          glm::normalize(glm::vec3(unit(random), unit(random), unit(random)) + 0.001f));
+                const float scale = scales(random);
+
+                auto model = glm::translate(glm::mat4(1.0f), position);
+                model = model * glm::mat4_cast(glm::normalize(rotation));
+                model = glm::scale(model, glm::vec3(scale));
+
+                const Mesh* mesh = meshes[objects.size() % meshes.size()];
+                objects.push_back({mesh, InstanceTransform::from(position, rotation, scale), objectBuffer.add(model)});
+            }
+        }
+    }
+
+    // the instanced path wants each mesh's transforms next to each other: one range per mesh in one buffer
+    std::vector<InstanceTransform> transforms;
+    std::array<GLsizei, meshes.size()> instanceCounts{};
+    std::array<GLuint, meshes.size()> firstInstances{};
+    for (std::size_t index = 0; index < meshes.size(); index++) {
+        firstInstances[index] = static_cast<GLuint>(transforms.size());
+        for (const Object& object : objects) {
+            if (object.mesh == meshes[index])
+                transforms.push_back(object.transform);
+        }
+        instanceCounts[index] = static_cast<GLsizei>(transforms.size() - firstInstances[index]);
+    }
+
+    const Buffer instanceBuffer(static_cast<GLsizeiptr>(transforms.size() * sizeof(InstanceTransform)), transforms.data());
+
+    // load textures
+    // ---------------
+    const Texture diffuseMap = Texture::load("resources/textures/container2.png");
+    const Texture specularMap = Texture::load("resources/textures/container2_specular.png");
+
+    // the mesh to draw object with, counting triangles for the title with and without detail levels
+    std::size_t trianglesDrawn = 0, trianglesFull = 0;
+    const auto select = [&](Object& object) -> const Mesh& {
+        const Mesh* mesh = object.mesh;
+        trianglesFull += mesh->indexCount / 3;
+        if (useLod && mesh == sphereLod.levels[0].mesh) {
+            const glm::vec4 translationScale = object.transform.translationScale;
+            mesh = sphereLod.levels[lodSelector.select(sphereLod, glm::vec3(translationScale), translationScale.w, object.lodLevel)].mesh;
+        }
+        trianglesDrawn += mesh->indexCount / 3;
+        return *mesh;
+    };
+
+    // render loop
+    // -----------------
+    float titleTimer = 0.0f;
+    int framesSinceTitle = 0;
+
+    while (!glfwWindowShouldClose(window)) {
+
+        // per-frame time logic
+        // --------------------
+        const auto currentFrame = static_cast<float>(glfwGetTime());
+        deltaTime = currentFrame - lastFrame;
+        lastFrame = currentFrame;
+
+        // input
+        // -----
+        processInput(window);
+
+        // shader hot-reload, only does work when a watched file changed
+        shaderWatcher.poll();
+
+        // render
+        // ------
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        // view/projection transformations, uploaded once for every program
+        frameUniforms.update(camera, static_cast<float>(SCR_WIDTH) / static_cast<float>(SCR_HEIGHT), currentFrame);
+        lodSelector.setView(camera, viewportHeight);
+        trianglesDrawn = trianglesFull = 0;
+
+        Shader& lightingShader = renderPath == RenderPath::Instanced ? instancedShader :
+                                 renderPath == RenderPath::MultiDraw ? multiDrawShader : objectShader;
+        lightingShader.use();
+        lightingShader.setVec3("light.position", lightPos);
+        lightingShader.setVec3("light.ambient", 0.2f, 0.2f, 0.2f);
+        lightingShader.setVec3("light.diffuse", 0.5f, 0.5f, 0.5f);
+        lightingShader.setVec3("light.specular", 1.0f, 1.0f, 1.0f);
+        lightingShader.setInt("material.diffuse", 0);
+        lightingShader.setInt("material.specular", 1);
+        lightingShader.setFloat("material.shininess", 64.0f);
+
+        diffuseMap.bind(0);
+        specularMap.bind(1);
+
+        // render the field
+        switch (renderPath) {
+            case RenderPath::Instanced:
+                for (std::size_t index = 0; index < meshes.size(); index++) {
+                    meshLibrary.drawInstanced(*meshes[index], lightingShader, instanceBuffer, instanceCounts[index], firstInstances[index]);
+                    trianglesFull += static_cast<std::size_t>(meshes[index]->indexCount / 3) * instanceCounts[index];
+                }
+                trianglesDrawn = trianglesFull;
+                break;
+            case RenderPath::MultiDraw:
+                // rebuilt every frame as a real scene would, the objects could move
+                drawList.clear();
+                for (Object& object : objects)
+                    drawList.add(lightingShader, select(object), object.transform);
+                drawList.submit();
+                break;
+            case RenderPath::PerObject:
+                // uploads all objects on the first frame only, nothing moves afterwards
+                objectBuffer.update();
+                for (Object& object : objects)
+                    meshLibrary.drawObjects(select(object), lightingShader, object.objectIndex);
+                break;
+        }
+
+        // also draw the lamp object
+        lightCubeShader.use();
+        lightCubeShader.setVec3("lightColor", glm::vec3(1.0f, 1.0f, 1.0f));
+        auto model = glm::mat4(1.0f);
+        model = translate(model, lightPos);
+        lightCubeShader.setMat4("model", model);
+
+        meshLibrary.draw(cube, lightCubeShader);
+
+        // frame time and GL calls in the title, refreshed twice a second
+        const GLStateStats calls = GLState::takeStats();
+        const UniformUploadStats uniforms = UniformTable::takeUploadStats();
+        framesSinceTitle++;
+        titleTimer += deltaTime;
+        if (titleTimer >= 0.5f) {
+            constexpr const char* PATH_NAMES[] = {"instanced", "multi-draw indirect", "one draw per object"};
+            std::ostringstream title;
+            title << "Cube Field - " << PATH_NAMES[static_cast<int>(renderPath)] << " - " << std::fixed << std::setprecision(2)
+                  << 1000.0f * titleTimer / static_cast<float>(framesSinceTitle) << " ms/frame, "
+                  << calls.forwarded + uniforms.uploads + calls.draws << " GL calls (" << calls.draws << " draws) for "
+                  << CUBE_COUNT << " objects (I to switch), " << trianglesDrawn / 1000 << "k of " << trianglesFull / 1000
+                  << "k triangles, LOD " << (useLod ? "on" : "off") << " (L)";
+            glfwSetWindowTitle(window, title.str().c_str());
+            titleTimer = 0.0f;
+            framesSinceTitle = 0;
+        }
+
+        // glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
+        // -------------------------------------------------------------------------------
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+
+    }
+
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+
+    return 0;
+}
+
+void processInput(GLFWwindow *window) {
+    float speedMultiplier{ 1.0f };
+
+    // Get current Alt key state
+    const int currentAltState = glfwGetKey(window, GLFW_KEY_LEFT_ALT);
+
+    // Check for single press (key was released before and is now pressed)
+    if (currentAltState == GLFW_PRESS && lastAltState == GLFW_RELEASE) {
+        // Toggle cursor lock
+        isCursorLocked = !isCursorLocked;
+
+        // Update cursor mode based on lock state
+        if (isCursorLocked) {
+            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+            firstMouse = true; // Reset first mouse
+        } else {
+            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+        }
+    }
+
+    // Store current state for next frame
+    lastAltState = currentAltState;
+
+    // switch render paths on a single press as well
+    const int currentRenderPathState = glfwGetKey(window, GLFW_KEY_I);
+    if (currentRenderPathState == GLFW_PRESS && lastRenderPathState == GLFW_RELEASE)
+        renderPath = static_cast<RenderPath>((static_cast<int>(renderPath) + 1) % 3);
+    lastRenderPathState = currentRenderPathState;
+
+    const int currentLodState = glfwGetKey(window, GLFW_KEY_L);
+    if (currentLodState == GLFW_PRESS && lastLodState == GLFW_RELEASE)
+        useLod = !useLod;
+    lastLodState = currentLodState;
+
+    // early return if cursor isn't locked
+    if (!isCursorLocked) return;
+
+    // move faster while shift is being held
+    if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS)
+        speedMultiplier = 3.0f;
+
+    // stop app
+    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+
+    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+        camera.ProcessKeyboard(FORWARD, deltaTime * speedMultiplier);
+    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+        camera.ProcessKeyboard(BACKWARD, deltaTime * speedMultiplier);
+    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+        camera.ProcessKeyboard(LEFT, deltaTime * speedMultiplier);
+    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+        camera.ProcessKeyboard(RIGHT, deltaTime * speedMultiplier);
+    if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS)
+        camera.ProcessKeyboard(UP, deltaTime * speedMultiplier);
+    if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS)
+        camera.ProcessKeyboard(DOWN, deltaTime * speedMultiplier);
+}
+
+// glfw: whenever the window size changed (by OS or user resize) this callback function executes
+// ---------------------------------------------------------------------------------------------
+void framebuffer_size_callback(GLFWwindow*, const int width, const int height) {
+    glViewport(0, 0, width, height);
+    viewportHeight = static_cast<float>(height);
+}
+
+// glfw: whenever the mouse moves, this callback is called
+// -------------------------------------------------------
+void mouse_callback(GLFWwindow*, const double xPosIn, const double yPosIn) {
+    if (!isCursorLocked) return;
+
+    const auto x_pos = static_cast<float>(xPosIn);
+    const auto y_pos = static_cast<float>(yPosIn);
+
+    if (firstMouse) {
+        lastX = x_pos;
+        lastY = y_pos;
+        firstMouse = false;
+    }
+
+    const float xOffset = x_pos - lastX;
+    const float yOffset = lastY - y_pos; // reversed since y-coordinates go from bottom to top
+
+    lastX = x_pos;
+    lastY = y_pos;
+
+    camera.ProcessMouseMovement(xOffset, yOffset);
+}
+
+// glfw: whenever the mouse scroll wheel scrolls, this callback is called
+// ----------------------------------------------------------------------
+void scroll_callback(GLFWwindow*, double, const double yoffset) {
+    if (!isCursorLocked) return;
+
+    camera.ProcessMouseScroll(static_cast<float>(yoffset));
+}
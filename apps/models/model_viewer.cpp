@@ -0,0 +1,446 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include <camera.h>
+#include <shader.h>
+#include <gl_objects.h>
+#include <mesh_library.h>
+#include <meshlet.h>
+#include <meshlet_culler.h>
+#include <mesh_optimizer.h>
+#include <gl_state.h>
+#include <obj_loader.h>
+#include <object_buffer.h>
+#include <shader_library.h>
+#include <frame_data.h>
+#include <shader_watcher.h>
+#include <streaming_buffer.h>
+
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+void framebuffer_size_callback(GLFWwindow* window, int width, int height);
+void mouse_callback(GLFWwindow* window, double xPosIn, double yPosIn);
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
+void processInput(GLFWwindow* window);
+void writeStressModel(const std::string& path);
+Texture makeBumpNormalMap();
+
+// settings
+constexpr unsigned int SCR_WIDTH = 1280;
+constexpr unsigned int SCR_HEIGHT = 720;
+int lastAltState = GLFW_RELEASE;
+int lastCullState = GLFW_RELEASE;
+
+// C toggles meshlet culling; without it the model is one plain draw
+bool cullMeshlets = true;
+
+// loaded when no OBJ is passed on the command line, and written first if it isn't there yet: a sphere of about
+// a million triangles
+const std::string STRESS_MODEL_PATH = "stress_sphere.obj";
+
+// Camera
+Camera camera{
+    glm::vec3(0.0f, 0.0f, 3.0f)
+};
+float lastX = SCR_WIDTH / 2.0f;
+float lastY = SCR_HEIGHT / 2.0f;
+bool firstMouse = false;
+bool isCursorLocked = true;
+
+// timing
+float deltaTime = 0.0f;
+float lastFrame = 0.0f;
+
+// lighting
+glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
+
+int main(const int argc, char** argv) {
+
+    // glfw initialise
+    // ---------------------
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    // glfw init window
+    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Model Viewer", nullptr, nullptr);
+    if (!window) {
+        std::cout << "Failed to create GLFW window" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetCursorPosCallback(window, mouse_callback);
+    glfwSetScrollCallback(window, scroll_callback);
+
+    // tell glfw to capture our mouse
+    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+
+    // load glad
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cout << "Failed to initialize GLAD" << std::endl;
+        glfwTerminate();
+        glfwDestroyWindow(window);
+        return -1;
+    }
+
+    // configure global open gl state
+    // ------------------------------
+    GLState::enable(GL_DEPTH_TEST);
+
+    // build and compile the shader programs
+    Shader::enableParallelCompile();
+    Shader lightCubeShader("resources/shaders/lighting/lighting_cube.vert", "resources/shaders/lighting/lighting_cube.frag", ShaderBuild::Async);
+
+    ShaderWatcher shaderWatcher;
+    shaderWatcher.watch(lightCubeShader);
+
+    ShaderLibrary shaderLibrary(&shaderWatcher);
+    shaderLibrary.add("material", "resources/shaders/material.vert", "resources/shaders/material.frag");
+    Shader& lightingShader = *shaderLibrary.get("material", {HAS_SPECULAR, HAS_NORMAL_MAP});
+
+    // per-frame camera data shared by every program
+    FrameUniforms frameUniforms;
+
+    MeshLibrary meshLibrary;
+    const Mesh& cube = *meshLibrary.get("cube");
+
+    // load the model
+    // --------------
+    const std::string modelPath = argc > 1 ? argv[1] : STRESS_MODEL_PATH;
+    if (argc <= 1 && !std::filesystem::exists(modelPath))
+        writeStressModel(modelPath);
+
+    ObjLoader objLoader;
+    const ObjMesh model = objLoader.load(modelPath);
+    const ObjLoadStats& loadStats = objLoader.getStats();
+
+    // meshlets only regroup the indices, the vertices still come straight out of the model (or its cache mapping)
+    const auto meshletStart = std::chrono::steady_clock::now();
+    const MeshData fallbackCube = model.empty() ? primitives::cube() : MeshData{};
+    const MeshView modelView = model.empty() ? MeshView(fallbackCube) : model.view;
+    const MeshletMesh modelMeshlets = meshlets::build(modelView);
+    const double meshletMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - meshletStart).count();
+    MeshletCuller meshletCuller(modelMeshlets);
+
+    const auto uploadStart = std::chrono::steady_clock::now();
+    // tangents come from the loader (or its cache) and ride along packed into one word per vertex
+    VertexFormat modelFormat;
+    modelFormat.tangent = TangentFormat::Int2_10_10_10;
+    const Mesh& modelMesh = model.empty() ? cube : meshLibrary.add("model", MeshView(model.view.vertices, modelMeshlets.indices,
+                                                                                     model.view.tangents), modelFormat);
+    const double uploadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - uploadStart).count();
+
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(1) << modelPath << ": " << loadStats.triangles << " triangles, "
+           << loadStats.vertices << " vertices in " << loadStats.totalMs + uploadMs << " ms";
+    if (loadStats.fromCache)
+        report << " (cache " << loadStats.cacheMs << " ms";
+    else
+        report << " (map " << loadStats.readMs << " ms, parse " << loadStats.parseMs << " ms, weld "
+               << loadStats.weldMs << " ms, optimize " << loadStats.optimizeMs << " ms, tangents "
+               << loadStats.tangentMs << " ms, cache write "
+               << loadStats.cacheMs << " ms";
+    report << ", meshlets " << meshletMs << " ms, upload " << uploadMs << " ms)";
+    std::cout << report.str() << std::endl;
+
+    if (!loadStats.fromCache) {
+        const MeshOptimizationStats& optimization = loadStats.optimization;
+        std::cout << std::fixed << std::setprecision(3) << "Optimized in " << optimization.milliseconds << " ms ("
+                  << loadStats.optimizeMs << " ms with analysis): ACMR " << optimization.cacheBefore.acmr << " -> "
+                  << optimization.cacheAfter.acmr << ", ATVR " << optimization.cacheBefore.atvr << " -> "
+                  << optimization.cacheAfter.atvr << ", overdraw " << optimization.overdrawBefore << " -> "
+                  << optimization.overdrawAfter << std::endl;
+    }
+    // what regrouping into meshlets costs the vertex cache, against the order the loader produced
+    const VertexCacheStats loadedCache = mesh_optimizer::analyzeVertexCache(modelView.indices, modelView.vertices.size());
+    const VertexCacheStats meshletCache = mesh_optimizer::analyzeVertexCache(modelMeshlets.indices, modelView.vertices.size());
+    std::cout << modelMeshlets.meshlets.size() << " meshlets of at most " << meshlets::MAX_VERTICES << " vertices and "
+              << meshlets::MAX_TRIANGLES << " triangles: ACMR " << loadedCache.acmr << " -> " << meshletCache.acmr
+              << ", ATVR " << loadedCache.atvr << " -> " << meshletCache.atvr << std::endl;
+    glfwSetWindowTitle(window, ("Model Viewer - " + report.str()).c_str());
+
+    // the surviving meshlets' commands, written each frame; one command per meshlet is the worst case
+    std::vector<DrawElementsIndirectCommand> commands;
+    commands.reserve(modelMeshlets.meshlets.size());
+    StreamingBuffer commandStream(static_cast<GLsizeiptr>(modelMeshlets.meshlets.size() * sizeof(DrawElementsIndirectCommand)));
+
+    // load textures
+    // ---------------
+    const Texture diffuseMap = Texture::load("resources/textures/container2.png");
+    const Texture specularMap = Texture::load("resources/textures/container2_specular.png");
+    const Texture normalMap = makeBumpNormalMap();
+
+    // render loop
+    // -----------------
+    float titleTimer = 0.0f;
+    double cullMs = 0.0;
+    int framesSinceTitle = 0;
+
+    while (!glfwWindowShouldClose(window)) {
+
+        // per-frame time logic
+        // --------------------
+        const auto currentFrame = static_cast<float>(glfwGetTime());
+        deltaTime = currentFrame - lastFrame;
+        lastFrame = currentFrame;
+
+        // input
+        // -----
+        processInput(window);
+
+        // shader hot-reload, only does work when a watched file changed
+        shaderWatcher.poll();
+
+        // render
+        // ------
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        // view/projection transformations, uploaded once for every program
+        frameUniforms.update(camera, static_cast<float>(SCR_WIDTH) / static_cast<float>(SCR_HEIGHT), currentFrame);
+
+        lightingShader.use();
+        lightingShader.setVec3("light.position", lightPos);
+        lightingShader.setVec3("light.ambient", 0.2f, 0.2f, 0.2f);
+        lightingShader.setVec3("light.diffuse", 0.5f, 0.5f, 0.5f);
+        lightingShader.setVec3("light.specular", 1.0f, 1.0f, 1.0f);
+        lightingShader.setInt("material.diffuse", 0);
+        lightingShader.setInt("material.specular", 1);
+        lightingShader.setInt("material.normal", 2);
+        lightingShader.setFloat("material.shininess", 64.0f);
+
+        // turn the model slowly; the normal matrix follows the model matrix
+        const glm::mat4 modelMatrix = glm::rotate(glm::mat4(1.0f), 0.3f * currentFrame, glm::vec3(0.0f, 1.0f, 0.0f));
+        lightingShader.setMat4("model", modelMatrix);
+        lightingShader.setMat3("normalMatrix", normalMatrix(modelMatrix));
+
+        diffuseMap.bind(0);
+        specularMap.bind(1);
+        normalMap.bind(2);
+
+        if (cullMeshlets && !model.empty()) {
+            // cull in the model's own space: the camera moves into it and the frustum comes out of it
+            const auto cullStart = std::chrono::steady_clock::now();
+            const glm::mat4 projection = camera.GetProjectionMatrix(static_cast<float>(SCR_WIDTH) / static_cast<float>(SCR_HEIGHT));
+            const glm::vec3 modelCamera = glm::vec3(glm::inverse(modelMatrix) * glm::vec4(camera.Position, 1.0f));
+            commands.clear();
+            meshletCuller.cull(modelMesh, modelCamera, Frustum::fromMatrix(projection * camera.GetViewMatrix() * modelMatrix), commands);
+            cullMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cullStart).count();
+
+            commandStream.beginFrame();
+            const StreamAllocation commandRange = commandStream.write(std::span<const DrawElementsIndirectCommand>(commands));
+            meshLibrary.drawIndirect(modelMesh, lightingShader, commandStream.getBuffer(), commandRange.offset,
+                                     static_cast<GLsizei>(commands.size()));
+        } else {
+            meshLibrary.draw(modelMesh, lightingShader);
+        }
+
+        // also draw the lamp object
+        lightCubeShader.use();
+        lightCubeShader.setVec3("lightColor", glm::vec3(1.0f, 1.0f, 1.0f));
+        auto lampModel = glm::mat4(1.0f);
+        lampModel = translate(lampModel, lightPos);
+        lampModel = scale(lampModel, glm::vec3(0.2f)); // a smaller cube
+        lightCubeShader.setMat4("model", lampModel);
+
+        meshLibrary.draw(cube, lightCubeShader);
+
+        // what the culling saved, refreshed twice a second
+        framesSinceTitle++;
+        titleTimer += deltaTime;
+        if (titleTimer >= 0.5f) {
+            const MeshletCullStats& cull = meshletCuller.getStats();
+            std::ostringstream title;
+            title << "Model Viewer - " << std::fixed << std::setprecision(2)
+                  << 1000.0f * titleTimer / static_cast<float>(framesSinceTitle) << " ms/frame - ";
+            if (cullMeshlets)
+                title << std::setprecision(1) << cull.culledPercentage() << "% of " << cull.triangles << " triangles culled, "
+                      << cull.visibleMeshlets << "/" << cull.meshlets << " meshlets in " << cull.commands << " commands, "
+                      << std::setprecision(3) << cullMs / framesSinceTitle << " ms to cull (C to toggle)";
+            else
+                title << "meshlet culling off (C to toggle)";
+            glfwSetWindowTitle(window, title.str().c_str());
+            titleTimer = 0.0f;
+            cullMs = 0.0;
+            framesSinceTitle = 0;
+        }
+
+        // glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
+        // -------------------------------------------------------------------------------
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+
+    }
+
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+
+    return 0;
+}
+
+/** A UV sphere of 1000 x 500 segments, just under a million triangles, as v/vt/vn lines and f v/vt/vn faces */
+void writeStressModel(const std::string& path) {
+    std::cout << "Writing " << path << " for the loader to read..." << std::endl;
+
+    const MeshData sphere = primitives::sphere(1000, 500);
+    std::ofstream out(path);
+    char line[160];
+    for (const Vertex& vertex : sphere.vertices) {
+        std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvt %.6f %.6f\nvn %.6f %.6f %.6f\n",
+                      vertex.position.x, vertex.position.y, vertex.position.z, vertex.texCoords.x, vertex.texCoords.y,
+                      vertex.normal.x, vertex.normal.y, vertex.normal.z);
+        out << line;
+    }
+    for (std::size_t first = 0; first + 2 < sphere.indices.size(); first += 3) {
+        const std::uint32_t a = sphere.indices[first] + 1;
+        const std::uint32_t b = sphere.indices[first + 1] + 1;
+        const std::uint32_t c = sphere.indices[first + 2] + 1;
+        out << "f " << a << '/' << a << '/' << a << ' ' << b << '/' << b << '/' << b << ' ' << c << '/' << c << '/' << c << '\n';
+    }
+}
+
+/** A tangent-space normal map of 16 x 16 round bumps, made up on the spot since the resources hold no normal map */
+Texture makeBumpNormalMap() {
+    constexpr int SIZE = 512;
+    constexpr int BUMPS = 16;
+    constexpr float CELL = static_cast<float>(SIZE) / BUMPS;
+
+    std::vector<std::uint8_t> pixels(SIZE * SIZE * 4);
+    for (int y = 0; y < SIZE; y++) {
+        for (int x = 0; x < SIZE; x++) {
+            // each cell holds a spherical cap of radius 0.4 cells; outside it the surface is flat
+            const glm::vec2 local = (glm::vec2(x, y) + 0.5f) / CELL - glm::floor((glm::vec2(x, y) + 0.5f) / CELL) - 0.5f;
+            const float distance = glm::length(local);
+            glm::vec3 normal(0.0f, 0.0f, 1.0f);
+            if (distance < 0.4f)
+                normal = glm::normalize(glm::vec3(local, std::sqrt(0.4f * 0.4f - distance * distance)));
+
+            std::uint8_t* pixel = &pixels[(y * SIZE + x) * 4];
+            pixel[0] = static_cast<std::uint8_t>(std::lround((normal.x * 0.5f + 0.5f) * 255.0f));
+            pixel[1] = static_cast<std::uint8_t>(std::lround((normal.y * 0.5f + 0.5f) * 255.0f));
+            pixel[2] = static_cast<std::uint8_t>(std::lround((normal.z * 0.5f + 0.5f) * 255.0f));
+            pixel[3] = 255;
+        }
+    }
+
+    Texture texture(SIZE, SIZE, GL_RGBA8, std::bit_width(static_cast<unsigned int>(SIZE)));
+    texture.upload(0, SIZE, SIZE, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    texture.generateMipmaps();
+    texture.setParameter(GL_TEXTURE_WRAP_S, GL_REPEAT);
+    texture.setParameter(GL_TEXTURE_WRAP_T, GL_REPEAT);
+    texture.setParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    texture.setParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return texture;
+}
+
+void processInput(GLFWwindow *window) {
+    float speedMultiplier{ 1.0f };
+
+    // Get current Alt key state
+    const int currentAltState = glfwGetKey(window, GLFW_KEY_LEFT_ALT);
+
+    // Check for single press (key was released before and is now pressed)
+    if (currentAltState == GLFW_PRESS && lastAltState == GLFW_RELEASE) {
+        // Toggle cursor lock
+        isCursorLocked = !isCursorLocked;
+
+        // Update cursor mode based on lock state
+        if (isCursorLocked) {
+            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+            firstMouse = true; // Reset first mouse
+        } else {
+            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+        }
+    }
+
+    // Store current state for next frame
+    lastAltState = currentAltState;
+
+    const int currentCullState = glfwGetKey(window, GLFW_KEY_C);
+    if (currentCullState == GLFW_PRESS && lastCullState == GLFW_RELEASE)
+        cullMeshlets = !cullMeshlets;
+    lastCullState = currentCullState;
+
+    // early return if cursor isn't locked
+    if (!isCursorLocked) return;
+
+    // move faster while shift is being held
+    if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS)
+        speedMultiplier = 3.0f;
+
+    // stop app
+    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+
+    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+        camera.ProcessKeyboard(FORWARD, deltaTime * speedMultiplier);
+    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+        camera.ProcessKeyboard(BACKWARD, deltaTime * speedMultiplier);
+    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+        camera.ProcessKeyboard(LEFT, deltaTime * speedMultiplier);
+    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+        camera.ProcessKeyboard(RIGHT, deltaTime * speedMultiplier);
+    if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS)
+        camera.ProcessKeyboard(UP, deltaTime * speedMultiplier);
+    if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS)
+        camera.ProcessKeyboard(DOWN, deltaTime * speedMultiplier);
+}
+
+// glfw: whenever the window size changed (by OS or user resize) this callback function executes
+// ---------------------------------------------------------------------------------------------
+void framebuffer_size_callback(GLFWwindow*, const int width, const int height) {
+    glViewport(0, 0, width, height);
+}
+
+// glfw: whenever the mouse moves, this callback is called
+// -------------------------------------------------------
+void mouse_callback(GLFWwindow*, const double xPosIn, const double yPosIn) {
+    if (!isCursorLocked) return;
+
+    const auto x_pos = static_cast<float>(xPosIn);
+    const auto y_pos = static_cast<float>(yPosIn);
+
+    if (firstMouse) {
+        lastX = x_pos;
+        lastY = y_pos;
+        firstMouse = false;
+    }
+
+    const float xOffset = x_pos - lastX;
+    const float yOffset = lastY - y_pos; // reversed since y-coordinates go from bottom to top
+
+    lastX = x_pos;
+    lastY = y_pos;
+
+    camera.ProcessMouseMovement(xOffset, yOffset);
+}
+
+// glfw: whenever the mouse scroll wheel scrolls, this callback is called
+// ----------------------------------------------------------------------
+void scroll_callback(GLFWwindow*, double, const double yoffset) {
+    if (!isCursorLocked) return;
+
+    camera.ProcessMouseScroll(static_cast<float>(yoffset));
+}
@@ -0,0 +1,96 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "gl_objects.h"
+#include "mesh_library.h"
+#include "streaming_buffer.h"
+#include "vertex_format.h"
+
+class Shader;
+
+// binding point of the DrawData storage block, must match "binding" in include/vertex_format.glsl
+constexpr GLuint DRAW_DATA_BINDING = 1;
+
+/** Layout glMultiDrawElementsIndirect reads from GL_DRAW_INDIRECT_BUFFER */
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+/** std430 mirror of DrawQuantization in include/vertex_format.glsl */
+struct DrawQuantization {
+    glm::vec4 positionScale;
+    glm::vec4 positionOffset;
+};
+
+static_assert(sizeof(DrawElementsIndirectCommand) == 20);
+static_assert(sizeof(DrawQuantization) == 32);
+
+/**
+ * Objects of any MeshLibrary mesh, collected per frame and drawn with one glMultiDrawElementsIndirect per bucket.
+ * A bucket is a shader plus what a single multi-draw can't vary: the vertex format and the index type. Copies of
+ * one mesh within a bucket become one command with several instances.
+ *
+ * Every command's baseInstance points at its objects' InstanceTransforms, which the instanced vertex array reads
+ * per instance; the mesh's dequantization is fetched by gl_DrawID. Shaders therefore need both INSTANCED and
+ * MULTI_DRAW. Other uniforms and the textures are not touched: set them on each shader before submit().
+ */
+class DrawList {
+public:
+    explicit DrawList(MeshLibrary& meshes);
+
+    DrawList(const DrawList&) = delete;
+    DrawList& operator=(const DrawList&) = delete;
+
+    void add(const Shader& shader, const Mesh& mesh, const InstanceTransform& transform);
+    void clear();
+
+    /**
+     * Write this frame's commands and instance data into the next region of the streaming buffer, then issue one
+     * multi-draw per bucket. Call once per frame: the region is reused three submits later.
+     */
+    void submit();
+
+    [[nodiscard]] std::size_t getBucketCount() const { return buckets.size(); }
+    [[nodiscard]] std::size_t getCommandCount() const { return commands.size(); }
+
+private:
+    struct Item {
+        const Mesh* mesh;
+        InstanceTransform transform;
+    };
+
+    struct Bucket {
+        const Shader* shader;
+        // held by value, a bucket outlives the meshes it once drew (MeshLibrary::remove)
+        std::uint32_t formatKey;
+        GLenum indexType;
+        std::vector<Item> items;
+        std::size_t firstCommand = 0;
+        std::size_t commandCount = 0;
+    };
+
+    MeshLibrary& meshes;
+    // a handful per frame, searched linearly
+    std::vector<Bucket> buckets;
+
+    std::vector<DrawElementsIndirectCommand> commands;
+    std::vector<InstanceTransform> transforms;
+    std::vector<DrawQuantization> quantizations;
+
+    // commands, transforms and draw data of a frame side by side in one region
+    StreamingBuffer stream;
+};
@@ -0,0 +1,54 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "camera.h"
+#include "streaming_buffer.h"
+
+// binding point of the FrameData uniform block, must match "binding" in the shaders
+constexpr GLuint FRAME_DATA_BINDING = 0;
+
+/**
+ * C++ mirror of the std140 FrameData uniform block every shader in resources/shaders declares.
+ * Members are ordered so std140 needs no implicit padding; the asserts below keep it that way.
+ */
+struct FrameData {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProj;
+    glm::vec4 cameraPosition; // w unused
+    float time;
+    float padding[3];
+};
+
+static_assert(offsetof(FrameData, view) == 0);
+static_assert(offsetof(FrameData, projection) == 64);
+static_assert(offsetof(FrameData, viewProj) == 128);
+static_assert(offsetof(FrameData, cameraPosition) == 192);
+static_assert(offsetof(FrameData, time) == 208);
+static_assert(sizeof(FrameData) == 224, "std140 rounds the block size up to a multiple of 16");
+
+/**
+ * Streams FrameData into a persistently mapped ring and binds this frame's copy to FRAME_DATA_BINDING; update once
+ * per frame, after the previous frame's draws, and every program sees it
+ */
+class FrameUniforms {
+public:
+    FrameUniforms();
+
+    void update(const Camera& camera, float aspectRatio, float time);
+    void update(const FrameData& data);
+
+    [[nodiscard]] const FrameData& getData() const { return data; }
+
+private:
+    StreamingBuffer stream;
+    GLsizeiptr alignment;
+    FrameData data{};
+};
@@ -0,0 +1,156 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <glad/glad.h>
+
+#include "gl_state.h"
+
+// deleters for GLHandle; each one also drops the name from the GLState mirror, GL reuses names
+// ---------------------------------------------------------------------------------------------------------------------
+namespace gl_detail {
+    void deleteBuffer(GLuint name);
+    void deleteVertexArray(GLuint name);
+    void deleteTexture(GLuint name);
+    void deleteFramebuffer(GLuint name);
+    void deleteRenderbuffer(GLuint name);
+}
+
+/** Move-only owner of a single GL object name; 0 means empty */
+template<void (*Delete)(GLuint)>
+class GLHandle {
+public:
+    GLHandle() = default;
+    explicit GLHandle(const GLuint name) : name(name) {}
+    ~GLHandle() { reset(); }
+
+    GLHandle(const GLHandle&) = delete;
+    GLHandle& operator=(const GLHandle&) = delete;
+
+    GLHandle(GLHandle&& other) noexcept : name(std::exchange(other.name, 0)) {}
+    GLHandle& operator=(GLHandle&& other) noexcept {
+        if (this != &other) {
+            reset();
+            name = std::exchange(other.name, 0);
+        }
+        return *this;
+    }
+
+    void reset() {
+        if (name)
+            Delete(name);
+        name = 0;
+    }
+
+    [[nodiscard]] GLuint get() const { return name; }
+
+private:
+    GLuint name = 0;
+};
+
+/**
+ * Immutable-storage buffer (glNamedBufferStorage). Pass GL_DYNAMIC_STORAGE_BIT in flags to be able to upload()
+ * after creation.
+ */
+class Buffer {
+public:
+    Buffer() = default;
+    Buffer(GLsizeiptr size, const void* data, GLbitfield flags = 0);
+
+    /** Storage for a whole array, typically constexpr vertex data */
+    template<typename T, std::size_t N>
+    explicit Buffer(const T (&data)[N], const GLbitfield flags = 0) : Buffer(sizeof(data), data, flags) {}
+
+    void upload(GLintptr offset, GLsizeiptr length, const void* data) const;
+    /** GPU-side copy of length bytes from source; the ranges may not overlap when source is this buffer */
+    void copy(const Buffer& source, GLintptr sourceOffset, GLintptr offset, GLsizeiptr length) const;
+    /** Map the whole buffer; with GL_MAP_PERSISTENT_BIT in both the storage flags and access it stays mapped for good */
+    [[nodiscard]] void* map(GLbitfield access) const;
+
+    void bind(const GLenum target) const { GLState::bindBuffer(target, handle.get()); }
+    void bindBase(const GLenum target, const GLuint index) const { GLState::bindBufferBase(target, index, handle.get()); }
+
+    [[nodiscard]] GLuint id() const { return handle.get(); }
+    [[nodiscard]] GLsizeiptr size() const { return byteSize; }
+
+private:
+    GLHandle<gl_detail::deleteBuffer> handle;
+    GLsizeiptr byteSize = 0;
+};
+
+/** Vertex array whose layout is described with the DSA attribute format calls, no binding involved */
+class VertexArray {
+public:
+    VertexArray();
+
+    void vertexBuffer(GLuint binding, const Buffer& buffer, GLintptr offset, GLsizei stride) const;
+    void elementBuffer(const Buffer& buffer) const;
+    /** Advance the attributes of binding once every divisor instances instead of once per vertex */
+    void bindingDivisor(GLuint binding, GLuint divisor) const;
+
+    /** Float attribute; integer types are converted, normalized or not */
+    void attribute(GLuint location, GLuint binding, GLint size, GLenum type, GLuint relativeOffset, bool normalized = false) const;
+
+    void bind() const { GLState::bindVertexArray(handle.get()); }
+
+    [[nodiscard]] GLuint id() const { return handle.get(); }
+
+private:
+    GLHandle<gl_detail::deleteVertexArray> handle;
+};
+
+/** 2D texture with immutable storage (glTextureStorage2D) */
+class Texture {
+public:
+    Texture() = default;
+    Texture(GLsizei width, GLsizei height, GLenum internalFormat, GLsizei levels = 1);
+
+    /** Load an image with stb_image, with a full mip chain and repeat wrapping; empty when the file can't be read */
+    static Texture load(const char* path);
+
+    void upload(GLint level, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels) const;
+    void generateMipmaps() const;
+    void setParameter(GLenum name, GLint value) const;
+
+    void bind(const GLuint unit) const { GLState::bindTexture(unit, handle.get()); }
+
+    [[nodiscard]] GLuint id() const { return handle.get(); }
+    [[nodiscard]] GLsizei getWidth() const { return width; }
+    [[nodiscard]] GLsizei getHeight() const { return height; }
+
+private:
+    GLHandle<gl_detail::deleteTexture> handle;
+    GLsizei width = 0;
+    GLsizei height = 0;
+};
+
+class Renderbuffer {
+public:
+    Renderbuffer() = default;
+    Renderbuffer(GLenum internalFormat, GLsizei width, GLsizei height);
+
+    [[nodiscard]] GLuint id() const { return handle.get(); }
+
+private:
+    GLHandle<gl_detail::deleteRenderbuffer> handle;
+};
+
+class Framebuffer {
+public:
+    Framebuffer();
+
+    void attach(GLenum attachment, const Texture& texture, GLint level = 0) const;
+    void attach(GLenum attachment, const Renderbuffer& renderbuffer) const;
+    [[nodiscard]] bool complete() const;
+
+    void bind(const GLenum target = GL_FRAMEBUFFER) const { GLState::bindFramebuffer(target, handle.get()); }
+
+    [[nodiscard]] GLuint id() const { return handle.get(); }
+
+private:
+    GLHandle<gl_detail::deleteFramebuffer> handle;
+};
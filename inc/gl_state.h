@@ -0,0 +1,121 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glad/glad.h>
+
+struct GLStateStats {
+    unsigned int forwarded = 0;
+    unsigned int avoided = 0;
+    unsigned int draws = 0;
+};
+
+/**
+ * Thin mirror of the binding and fixed-function state the apps touch. Every call compares against the mirror and
+ * only reaches GL when it would change something. The mirror starts out unknown, so the first call of each kind
+ * is always forwarded; call invalidate() after code that changes state behind its back (ImGui, for one).
+ *
+ * Textures are bound per unit through glBindTextureUnit, so the active texture unit never changes. Objects that
+ * are deleted must be forgotten, GL hands their names out again.
+ */
+class GLState {
+public:
+    static constexpr GLuint UNKNOWN = 0xFFFFFFFFu;
+    static constexpr std::size_t MAX_TEXTURE_UNITS = 32;
+    static constexpr std::size_t MAX_BUFFER_BINDINGS = 16;
+
+    static void useProgram(GLuint program);
+    static void bindProgramPipeline(GLuint pipeline);
+    static void bindVertexArray(GLuint vertexArray);
+    static void bindTexture(GLuint unit, GLuint texture);
+    static void bindBuffer(GLenum target, GLuint buffer);
+    static void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+    /** Always forwarded, ranges are not mirrored */
+    static void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+    static void bindFramebuffer(GLenum target, GLuint framebuffer);
+
+    static void enable(GLenum capability);
+    static void disable(GLenum capability);
+    static void depthFunc(GLenum func);
+    static void depthMask(bool write);
+    static void blendFunc(GLenum source, GLenum destination);
+
+    /** Draws aren't state, but counting them next to the forwarded calls gives the GL calls a frame makes */
+    static void recordDraw() { stats.draws++; }
+
+    /** Forget everything, the next call of each kind is forwarded */
+    static void invalidate();
+
+    static void forgetProgram(GLuint program);
+    static void forgetPipeline(GLuint pipeline);
+    static void forgetVertexArray(GLuint vertexArray);
+    static void forgetTexture(GLuint texture);
+    static void forgetBuffer(GLuint buffer);
+    static void forgetFramebuffer(GLuint framebuffer);
+
+    /** Calls forwarded and avoided, and draws recorded, since the previous call, which resets the counters */
+    static GLStateStats takeStats() {
+        const GLStateStats taken = stats;
+        stats = {};
+        return taken;
+    }
+
+private:
+    // generic buffer targets that are mirrored; anything else is always forwarded
+    static constexpr std::array<GLenum, 9> BUFFER_TARGETS = {
+        GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER, GL_SHADER_STORAGE_BUFFER, GL_DRAW_INDIRECT_BUFFER,
+        GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, GL_PIXEL_UNPACK_BUFFER, GL_PIXEL_PACK_BUFFER
+    };
+    static constexpr std::array<GLenum, 8> CAPABILITIES = {
+        GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, GL_SCISSOR_TEST, GL_STENCIL_TEST, GL_FRAMEBUFFER_SRGB, GL_MULTISAMPLE,
+        GL_PROGRAM_POINT_SIZE
+    };
+
+    struct Mirror {
+        GLuint program = UNKNOWN;
+        GLuint pipeline = UNKNOWN;
+        GLuint vertexArray = UNKNOWN;
+        GLuint drawFramebuffer = UNKNOWN;
+        GLuint readFramebuffer = UNKNOWN;
+        std::array<GLuint, MAX_TEXTURE_UNITS> textures{};
+        std::array<GLuint, BUFFER_TARGETS.size()> buffers{};
+        std::array<GLuint, MAX_BUFFER_BINDINGS> uniformBuffers{};
+        std::array<GLuint, MAX_BUFFER_BINDINGS> storageBuffers{};
+        // -1 unknown, 0 disabled, 1 enabled
+        std::array<std::int8_t, CAPABILITIES.size()> capabilities{};
+        GLenum depthFunc = UNKNOWN;
+        std::int8_t depthMask = -1;
+        GLenum blendSource = UNKNOWN;
+        GLenum blendDestination = UNKNOWN;
+
+        Mirror() {
+            textures.fill(UNKNOWN);
+            buffers.fill(UNKNOWN);
+            uniformBuffers.fill(UNKNOWN);
+            storageBuffers.fill(UNKNOWN);
+            capabilities.fill(-1);
+        }
+    };
+
+    static inline Mirror mirror;
+    static inline GLStateStats stats;
+
+    /** Record value in slot; false when it was already there and the GL call can be dropped */
+    template<typename T>
+    static bool changes(T& slot, const T value) {
+        if (slot == value) {
+            stats.avoided++;
+            return false;
+        }
+        slot = value;
+        stats.forwarded++;
+        return true;
+    }
+
+    static void setCapability(GLenum capability, bool enabled);
+};
@@ -0,0 +1,75 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "gl_objects.h"
+#include "offset_allocator.h"
+
+/**
+ * Ranges of one large immutable buffer, handed out by an OffsetAllocator so meshes can come and go without
+ * re-uploading the rest. Running out of space moves everything into a buffer twice the size on the GPU, offsets
+ * unchanged; compact() closes the holes left by free(), which does move ranges.
+ *
+ * Both replace the buffer and bump getGeneration(), after which users re-point their vertex arrays and re-read
+ * getOffset() for every handle.
+ */
+class GpuBufferArena {
+public:
+    using Handle = std::uint32_t;
+    static constexpr Handle INVALID_HANDLE = 0xFFFFFFFFu;
+
+    explicit GpuBufferArena(GLsizeiptr capacity);
+
+    GpuBufferArena(const GpuBufferArena&) = delete;
+    GpuBufferArena& operator=(const GpuBufferArena&) = delete;
+
+    /** A range of size bytes starting on a multiple of alignment, which needn't be a power of two */
+    [[nodiscard]] Handle allocate(GLsizeiptr size, GLsizeiptr alignment = GRANULARITY);
+    void free(Handle handle);
+
+    void upload(Handle handle, const void* data, GLsizeiptr size) const;
+
+    /** Pack all ranges at the start of a fresh buffer, leaving the free space in one piece */
+    void compact();
+
+    [[nodiscard]] GLintptr getOffset(Handle handle) const { return ranges[handle].offset; }
+    [[nodiscard]] const Buffer& getBuffer() const { return buffer; }
+    [[nodiscard]] unsigned int getGeneration() const { return generation; }
+
+    [[nodiscard]] GLsizeiptr getCapacity() const { return buffer.size(); }
+    [[nodiscard]] GLsizeiptr getUsedBytes() const { return usedBytes; }
+    /** 0 when the free space is one block, towards 1 as it splinters into holes too small to use */
+    [[nodiscard]] float getFragmentation() const;
+
+private:
+    // allocator unit; vertex strides and index blocks are multiples of 4, most of 16
+    static constexpr GLsizeiptr GRANULARITY = 16;
+
+    struct Range {
+        OffsetAllocator::Allocation block;
+        GLintptr offset = 0;
+        GLsizeiptr size = 0;
+        GLsizeiptr alignment = 0;
+        bool live = false;
+    };
+
+    /** Place range within a fresh block of the allocator, false when no block is large enough */
+    bool place(Range& range);
+    void grow(GLsizeiptr needed);
+
+    OffsetAllocator allocator;
+    Buffer buffer;
+    unsigned int generation = 0;
+    GLsizeiptr usedBytes = 0;
+
+    // indexed by Handle; freed slots are reused
+    std::vector<Range> ranges;
+    std::vector<Handle> freeHandles;
+};
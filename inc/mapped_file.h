@@ -0,0 +1,40 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Read-only view of a whole file. On Linux the file is mmap'ed and pages come in as they are touched; elsewhere it
+ * is read into memory in one go. Empty when the file can't be opened.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    [[nodiscard]] std::span<const std::byte> bytes() const { return {data, size}; }
+    [[nodiscard]] std::string_view text() const { return {reinterpret_cast<const char*>(data), size}; }
+    [[nodiscard]] bool empty() const { return size == 0; }
+
+private:
+    void release();
+
+    const std::byte* data = nullptr;
+    std::size_t size = 0;
+    // true when data points into a mapping rather than into fallback
+    bool mapped = false;
+    std::vector<std::byte> fallback;
+};
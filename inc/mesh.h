@@ -0,0 +1,52 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/** The vertex layout every mesh shares: location 0 position, 1 normal, 2 texture coordinates */
+struct Vertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoords;
+};
+
+/** CPU-side indexed triangle list, counter-clockwise front faces */
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<std::uint32_t> indices;
+    // one per vertex when generated (see generateTangents), otherwise empty: xyz along +u, w the bitangent's sign
+    std::vector<glm::vec4> tangents;
+};
+
+/** Non-owning MeshData, for meshes that live in a mapped file or elsewhere outside a MeshData */
+struct MeshView {
+    std::span<const Vertex> vertices;
+    std::span<const std::uint32_t> indices;
+    std::span<const glm::vec4> tangents;
+
+    MeshView() = default;
+    MeshView(const std::span<const Vertex> vertices, const std::span<const std::uint32_t> indices,
+             const std::span<const glm::vec4> tangents = {})
+        : vertices(vertices), indices(indices), tangents(tangents) {}
+    MeshView(const MeshData& data) : vertices(data.vertices), indices(data.indices), tangents(data.tangents) {}
+};
+
+// procedural primitives, all centred on the origin and sized to fit the unit cube [-0.5, 0.5]
+// ---------------------------------------------------------------------------------------------------------------------
+namespace primitives {
+    /** 24 vertices (4 per face, so every face keeps its own normal and UVs) and 36 indices */
+    MeshData cube();
+
+    /** Plane in XZ facing +Y, split into subdivisions x subdivisions quads */
+    MeshData plane(int subdivisions = 1);
+
+    /** UV sphere of radius 0.5; the seam column and the pole rows are duplicated for the texture coordinates */
+    MeshData sphere(int segments = 32, int rings = 16);
+}
@@ -0,0 +1,157 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+#include <glad/glad.h>
+
+#include "gl_objects.h"
+#include "gpu_buffer_arena.h"
+#include "mesh.h"
+#include "vertex_format.h"
+
+class Shader;
+
+/** Where one mesh lives inside the MeshLibrary buffers */
+struct Mesh {
+    GLsizei indexCount = 0;
+    GLenum indexType = GL_UNSIGNED_SHORT;
+    // byte offset into the shared index buffer; changes when MeshLibrary::compact() moves the mesh
+    std::uintptr_t indexOffset = 0;
+    // added to every index by glDrawElementsBaseVertex, so indices stay local to the mesh and fit in 16 bits
+    GLint baseVertex = 0;
+    GLsizei vertexCount = 0;
+
+    VertexFormat format;
+    VertexQuantization quantization;
+};
+
+/** GPU memory of a MeshLibrary, next to what the same meshes would take as plain float vertices */
+struct MeshMemoryStats {
+    std::size_t vertexBytes = 0;
+    std::size_t floatVertexBytes = 0;
+    std::size_t indexBytes = 0;
+    // capacity of both arenas, and the worse of their fragmentations
+    std::size_t arenaBytes = 0;
+    float fragmentation = 0.0f;
+};
+
+/**
+ * Vertex data read by draws since the last takeDrawStats(), counting each vertex of a mesh once per draw or
+ * instance; instance transforms and object data are included in both byte counts
+ */
+struct MeshDrawStats {
+    unsigned int draws = 0;
+    unsigned int instances = 0;
+    std::size_t fetchedBytes = 0;
+    std::size_t floatFetchedBytes = 0;
+};
+
+/**
+ * Indexed meshes sharing one vertex and one index GpuBufferArena. Each mesh uses 16-bit indices unless it has more
+ * than 65536 vertices, and picks its own VertexFormat; every mesh of a format is drawn through the same vertex array,
+ * so any set of them fits a single multi-draw. The cube, plane and sphere primitives are always present as float
+ * meshes.
+ *
+ * add() uploads just the new mesh and remove() frees its ranges for reuse. A Mesh stays valid until it is removed,
+ * also when the arenas grow or compact() moves it.
+ */
+class MeshLibrary {
+public:
+    MeshLibrary();
+
+    MeshLibrary(const MeshLibrary&) = delete;
+    MeshLibrary& operator=(const MeshLibrary&) = delete;
+
+    const Mesh& add(std::string_view name, MeshView data, VertexFormat format = {});
+    /** Free the mesh's ranges; references to it dangle from here on */
+    void remove(std::string_view name);
+
+    /** Close the holes left by remove(), moving meshes towards the start of the arenas */
+    void compact();
+
+    /** The mesh added under name, or nullptr when there is none */
+    [[nodiscard]] const Mesh* get(std::string_view name) const;
+
+    /** Bind the vertex array for mesh's format */
+    void bind(const Mesh& mesh);
+
+    /**
+     * Draw mesh with the program pipeline in use. shader receives the dequantization uniforms of
+     * include/vertex_format.glsl, which its vertex stage must use to read the mesh.
+     */
+    void draw(const Mesh& mesh, const Shader& shader);
+
+    /**
+     * Draw count copies of mesh in one call, placed by the InstanceTransforms in instances starting at element first.
+     * shader has to be built with the INSTANCED feature, which reads them in place of the model uniform.
+     */
+    void drawInstanced(const Mesh& mesh, const Shader& shader, const Buffer& instances, GLsizei count, GLuint first = 0);
+
+    /**
+     * Draw count copies of mesh placed by the ObjectBuffer entries first to first + count - 1, in one call that
+     * uploads no uniforms beyond the mesh's dequantization. shader has to be built with the OBJECT_DATA feature.
+     */
+    void drawObjects(const Mesh& mesh, const Shader& shader, GLuint first, GLsizei count = 1);
+
+    /**
+     * Draw count DrawElementsIndirectCommands read from commands at offset, each a range of mesh's indices, in one
+     * glMultiDrawElementsIndirect through the plain vertex array. Commands come from the caller, so the vertex fetch
+     * statistics don't count them.
+     */
+    void drawIndirect(const Mesh& mesh, const Shader& shader, const Buffer& commands, GLintptr offset, GLsizei count);
+
+    /**
+     * Bind the instanced vertex array for mesh's format reading InstanceTransforms from instances, starting offset
+     * bytes in, for custom draws
+     */
+    void bindInstanced(const Mesh& mesh, const Shader& shader, const Buffer& instances, GLintptr offset = 0);
+
+    [[nodiscard]] std::size_t getMeshCount() const { return meshes.size(); }
+    [[nodiscard]] MeshMemoryStats getMemoryStats() const;
+    [[nodiscard]] MeshDrawStats takeDrawStats();
+
+    [[nodiscard]] const GpuBufferArena& getVertexArena() const { return vertexArena; }
+    [[nodiscard]] const GpuBufferArena& getIndexArena() const { return indexArena; }
+
+private:
+    struct Entry {
+        Mesh mesh;
+        GpuBufferArena::Handle vertices = GpuBufferArena::INVALID_HANDLE;
+        GpuBufferArena::Handle indices = GpuBufferArena::INVALID_HANDLE;
+    };
+
+    /** Re-read every mesh's offsets and re-point the vertex arrays once an arena has replaced its buffer */
+    void relocate();
+    /** Hand the mesh's dequantization to shader */
+    void prepare(const Mesh& mesh, const Shader& shader);
+
+    // name hash -> mesh
+    std::unordered_map<std::uint64_t, Entry> meshes;
+
+    // each vertex range starts at a multiple of its mesh's stride so baseVertex can address it; each index range is
+    // 4-byte aligned because both widths share the buffer
+    GpuBufferArena vertexArena;
+    GpuBufferArena indexArena;
+    unsigned int vertexGeneration = 0;
+    unsigned int indexGeneration = 0;
+
+    MeshMemoryStats memory;
+    MeshDrawStats drawStats;
+
+    // instanced draws use a second vertex array, so no attribute is ever enabled without a buffer behind it
+    struct Layout {
+        VertexFormat format;
+        VertexArray vertexArray;
+        VertexArray instancedVertexArray;
+    };
+
+    // VertexFormat::key() -> vertex arrays with that layout
+    std::unordered_map<std::uint32_t, Layout> layouts;
+};
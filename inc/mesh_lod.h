@@ -0,0 +1,73 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "mesh.h"
+#include "mesh_library.h"
+#include "thread_pool.h"
+
+class Camera;
+
+/** One level of a LodMesh */
+struct MeshLod {
+    const Mesh* mesh = nullptr;
+    std::size_t triangles = 0;
+    // largest deviation from level 0 in object-space units, 0 for level 0 itself
+    float error = 0.0f;
+};
+
+/** Detail levels of one mesh, finest first, each with about half the triangles of the one before */
+struct LodMesh {
+    std::vector<MeshLod> levels;
+    // bounding sphere around the object-space origin
+    float radius = 0.0f;
+
+    [[nodiscard]] bool empty() const { return levels.empty(); }
+};
+
+/**
+ * Simplify data into up to levelCount levels with simplifyMesh, one ThreadPool task per level, and add them all to
+ * library: level 0 under name, the others under "name#lod<level>". A level that can't shed a fifth of the triangles
+ * of the one before (seams and borders are locked) ends the chain early.
+ */
+LodMesh addLodMesh(MeshLibrary& library, ThreadPool& pool, std::string_view name, const MeshData& data,
+                   std::size_t levelCount = 5, VertexFormat format = {});
+
+/**
+ * Picks the coarsest level whose error, projected at the object's distance, stays below a pixel threshold.
+ *
+ * A sphere of world-space size e at distance d covers e * h / (2 d tan(fov / 2)) pixels of a viewport h pixels tall,
+ * d being measured to the near side of the bounding sphere so the estimate errs on the fine side. Each object keeps
+ * its current level until that level exceeds the threshold by the hysteresis fraction, or a coarser one falls below
+ * it by the same fraction; without that margin an object parked on a boundary flips between levels every frame.
+ */
+class LodSelector {
+public:
+    explicit LodSelector(float pixelThreshold = 1.0f, float hysteresis = 0.25f);
+
+    /** Call once per frame before select */
+    void setView(const Camera& camera, float viewportHeight);
+
+    /** Level of lod to draw for an object at centre, scaled uniformly by scale; current is the object's own state */
+    std::size_t select(const LodMesh& lod, const glm::vec3& centre, float scale, std::uint8_t& current) const;
+
+    void setPixelThreshold(const float threshold) { pixelThreshold = threshold; }
+    [[nodiscard]] float getPixelThreshold() const { return pixelThreshold; }
+
+private:
+    float pixelThreshold;
+    float hysteresis;
+
+    glm::vec3 cameraPosition{};
+    // pixels covered by one world unit at distance 1
+    float pixelsPerUnit = 1.0f;
+};
@@ -0,0 +1,65 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "mesh.h"
+
+/**
+ * Post-transform vertex cache efficiency of an index order under a FIFO cache. ACMR is vertex shader invocations
+ * per triangle (0.5 is the ideal for large regular meshes, 3 the worst); ATVR is invocations per unique vertex
+ * (1 is ideal).
+ */
+struct VertexCacheStats {
+    float acmr = 0.0f;
+    float atvr = 0.0f;
+};
+
+/** Before and after of mesh_optimizer::optimize; overdraw is shaded / covered pixels, averaged over six views */
+struct MeshOptimizationStats {
+    VertexCacheStats cacheBefore;
+    VertexCacheStats cacheAfter;
+    float overdrawBefore = 0.0f;
+    float overdrawAfter = 0.0f;
+    double milliseconds = 0.0;
+};
+
+// import-time reordering of indexed triangle lists; none of it changes what is drawn, only the order
+// ---------------------------------------------------------------------------------------------------------------------
+namespace mesh_optimizer {
+    // FIFO entries assumed by the optimizer and the analysis; small enough to suit every desktop GPU
+    constexpr std::uint32_t CACHE_SIZE = 16;
+
+    [[nodiscard]] VertexCacheStats analyzeVertexCache(std::span<const std::uint32_t> indices, std::size_t vertexCount,
+                                                      std::uint32_t cacheSize = CACHE_SIZE);
+
+    /** Rasterize the mesh front-to-back from the six axis directions in software and compare shaded to covered pixels */
+    [[nodiscard]] float analyzeOverdraw(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices);
+
+    /**
+     * Tipsify (Sander et al. 2007): fan out around the vertex most likely to still be cached. When clusters is
+     * given it receives the first triangle of every run that had to restart from a dead end; runs can be reordered
+     * among themselves without losing much cache efficiency.
+     */
+    void optimizeVertexCache(std::vector<std::uint32_t>& indices, std::size_t vertexCount,
+                             std::vector<std::uint32_t>* clusters = nullptr);
+
+    /**
+     * Split the runs from optimizeVertexCache further wherever the ACMR so far stays within threshold times the run's
+     * own, then draw the outward-facing clusters first so they occlude the rest
+     */
+    void optimizeOverdraw(std::vector<std::uint32_t>& indices, std::span<const Vertex> vertices,
+                          const std::vector<std::uint32_t>& clusters, float threshold = 1.05f);
+
+    /** Renumber vertices in the order the indices first use them, so fetches walk the vertex buffer forwards */
+    void optimizeVertexFetch(MeshData& data);
+
+    /** All three in order; measuring overdraw costs a software rasterization, more than the optimization itself */
+    MeshOptimizationStats optimize(MeshData& data, bool measureOverdraw = true);
+}
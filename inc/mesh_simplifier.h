@@ -0,0 +1,28 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+#include "mesh.h"
+
+/** A simplified mesh and how far it strays from the original, in object-space units */
+struct SimplifiedMesh {
+    MeshData data;
+    float error = 0.0f;
+};
+
+/**
+ * Quadric error edge collapse (Garland and Heckbert 1997) down to targetTriangles, or until the next collapse would
+ * cost more than maxError. Collapses move a vertex onto a neighbour, so no attribute is ever interpolated; the cost
+ * adds the attribute change over the edge, scaled by its squared length and attributeWeight, to the geometric one.
+ *
+ * Open borders and attribute seams (a position shared by vertices with different normals or texture coordinates)
+ * are locked, which keeps silhouettes and texture layouts intact at the price of a floor on how far a heavily
+ * seamed mesh can go. Safe to call from several threads at once.
+ */
+[[nodiscard]] SimplifiedMesh simplifyMesh(const MeshData& data, std::size_t targetTriangles,
+                                          float maxError = std::numeric_limits<float>::max(), float attributeWeight = 1.0f);
@@ -0,0 +1,59 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "mesh.h"
+
+/** A run of MeshletMesh::indices, short enough to cull as a whole */
+struct Meshlet {
+    // into MeshletMesh::indices, a multiple of three
+    std::uint32_t firstIndex = 0;
+    std::uint32_t triangleCount = 0;
+    std::uint32_t vertexCount = 0;
+};
+
+/**
+ * Bounding sphere and normal cone of a meshlet. Seen from a point p, every triangle of the meshlet faces away when
+ * dot(centre - p, coneAxis) >= coneCutoff * length(centre - p) + radius; a cone too wide to ever pass that test has
+ * coneCutoff 1.
+ */
+struct MeshletBounds {
+    glm::vec3 centre{};
+    float radius = 0.0f;
+    glm::vec3 coneAxis{0.0f, 0.0f, 1.0f};
+    float coneCutoff = 1.0f;
+};
+
+/** A mesh's triangles regrouped into meshlets; the indices still refer to the original vertex buffer */
+struct MeshletMesh {
+    std::vector<std::uint32_t> indices;
+    std::vector<Meshlet> meshlets;
+    std::vector<MeshletBounds> bounds;
+};
+
+// clusters of the sizes mesh shader hardware is tuned for, also a good granularity for culling on the CPU
+// ---------------------------------------------------------------------------------------------------------------------
+namespace meshlets {
+    constexpr std::size_t MAX_VERTICES = 64;
+    constexpr std::size_t MAX_TRIANGLES = 124;
+
+    /**
+     * Grow each meshlet from a seed triangle by repeatedly adding the neighbouring triangle that brings the fewest new
+     * vertices, so meshlets come out compact and their cones narrow. Seeds follow the index order, which after
+     * mesh_optimizer is already spatially coherent. Each meshlet's triangles are then put back in index order and
+     * reordered for the vertex cache within the meshlet, since the meshlet is also what gets drawn.
+     */
+    [[nodiscard]] MeshletMesh build(const MeshView& mesh, std::size_t maxVertices = MAX_VERTICES,
+                                    std::size_t maxTriangles = MAX_TRIANGLES);
+
+    [[nodiscard]] MeshletBounds computeBounds(std::span<const Vertex> vertices, std::span<const std::uint32_t> indices);
+}
@@ -0,0 +1,70 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "draw_list.h"
+#include "mesh_library.h"
+#include "meshlet.h"
+
+/** Six inward-facing planes, xyz the unit normal and w the offset, so a point p is inside when dot(xyz, p) + w >= 0 */
+struct Frustum {
+    std::array<glm::vec4, 6> planes;
+
+    /**
+     * The planes of clip space pulled back through matrix (Gribb and Hartmann). Pass projection * view * model to
+     * get them in the model's space, which is where MeshletCuller wants them.
+     */
+    static Frustum fromMatrix(const glm::mat4& matrix);
+};
+
+/** Meshlets and triangles seen by the last MeshletCuller::cull, and how many of them survived */
+struct MeshletCullStats {
+    std::size_t meshlets = 0;
+    std::size_t visibleMeshlets = 0;
+    std::size_t triangles = 0;
+    std::size_t visibleTriangles = 0;
+    std::size_t commands = 0;
+
+    [[nodiscard]] float culledPercentage() const {
+        return triangles == 0 ? 0.0f : 100.0f * static_cast<float>(triangles - visibleTriangles) / static_cast<float>(triangles);
+    }
+};
+
+/**
+ * Rejects the meshlets of one MeshletMesh that are outside the frustum or face away from the camera, four at a time
+ * with SSE (scalar where SSE2 isn't available), and turns the survivors into indirect draw commands. Neighbouring
+ * survivors are adjacent in the index buffer and merge into one command, so a mostly visible mesh still costs only
+ * a few.
+ *
+ * Bounds are kept as structure-of-arrays padded to a multiple of four, so four meshlets' worth of a field is one load.
+ */
+class MeshletCuller {
+public:
+    explicit MeshletCuller(const MeshletMesh& mesh);
+
+    /**
+     * Append the commands drawing the visible meshlets of mesh, which must hold the MeshletMesh's indices.
+     * cameraPosition and frustum are in the mesh's object space.
+     */
+    void cull(const Mesh& mesh, const glm::vec3& cameraPosition, const Frustum& frustum,
+              std::vector<DrawElementsIndirectCommand>& commands, GLuint baseInstance = 0);
+
+    [[nodiscard]] const MeshletCullStats& getStats() const { return stats; }
+
+private:
+    std::size_t meshletCount = 0;
+
+    std::vector<float> centreX, centreY, centreZ, radius;
+    std::vector<float> coneX, coneY, coneZ, coneCutoff;
+    std::vector<Meshlet> meshlets;
+
+    MeshletCullStats stats;
+};
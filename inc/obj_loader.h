@@ -0,0 +1,69 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "mapped_file.h"
+#include "mesh.h"
+#include "mesh_optimizer.h"
+#include "thread_pool.h"
+
+/** Where the time of the last ObjLoader::load went, in milliseconds */
+struct ObjLoadStats {
+    bool fromCache = false;
+    double readMs = 0.0;
+    double parseMs = 0.0;
+    double weldMs = 0.0;
+    double optimizeMs = 0.0;
+    double tangentMs = 0.0;
+    double cacheMs = 0.0;
+    double totalMs = 0.0;
+    std::size_t triangles = 0;
+    std::size_t vertices = 0;
+    // filled when the model was parsed rather than read from the cache
+    MeshOptimizationStats optimization;
+};
+
+/**
+ * A loaded model. view points into data after a parse and into cache after a cache hit, in which case nothing was
+ * copied out of the mapped file; hand view to MeshLibrary::add.
+ */
+struct ObjMesh {
+    MeshData data;
+    MappedFile cache;
+    MeshView view;
+
+    [[nodiscard]] bool empty() const { return view.indices.empty(); }
+};
+
+/**
+ * Wavefront OBJ reader for triangle and polygon meshes: v, vt, vn and f lines, fans for faces of more than three
+ * corners, negative (relative) indices. Everything else (groups, materials, smoothing groups) is skipped.
+ *
+ * The file is mapped and cut into chunks at line ends that a ThreadPool parses with std::from_chars; corners are
+ * then welded into unique vertices through a hash map. Models without normals get smooth, area-weighted ones.
+ * mesh_optimizer then reorders triangles and vertices for the GPU and generateTangents adds MikkTSpace tangents,
+ * a one-off cost since the result is written to "<path>.meshcache", which later loads reuse as long as the OBJ's
+ * size and modification time still match: one mmap, no parsing, no optimizing and no tangent generation.
+ */
+class ObjLoader {
+public:
+    /** 0 uses one thread per hardware thread */
+    explicit ObjLoader(std::size_t threadCount = 0);
+
+    /** Empty ObjMesh when the file can't be read or holds no faces */
+    [[nodiscard]] ObjMesh load(const std::string& path);
+
+    [[nodiscard]] const ObjLoadStats& getStats() const { return stats; }
+
+private:
+    bool loadCache(const std::string& path, ObjMesh& mesh);
+    void writeCache(const std::string& path, const MeshData& data);
+
+    ThreadPool pool;
+    ObjLoadStats stats;
+};
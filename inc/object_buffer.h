@@ -0,0 +1,74 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "gl_objects.h"
+
+// binding point of the ObjectData storage block, must match "binding" in material.vert
+constexpr GLuint OBJECT_DATA_BINDING = 2;
+
+/**
+ * std430 mirror of ObjectData in material.vert. A mat3 is three vec4-aligned columns there, hence mat3x4;
+ * materialIndex is padded out to the struct's 16-byte alignment.
+ */
+struct ObjectData {
+    glm::mat4 model;
+    glm::mat3x4 normalMatrix;
+    std::uint32_t materialIndex;
+    std::uint32_t padding[3];
+};
+
+static_assert(offsetof(ObjectData, model) == 0);
+static_assert(offsetof(ObjectData, normalMatrix) == 64);
+static_assert(offsetof(ObjectData, materialIndex) == 112);
+static_assert(sizeof(ObjectData) == 128);
+
+/** Inverse transpose of model's upper 3x3, which keeps normals perpendicular under non-uniform scale */
+glm::mat3 normalMatrix(const glm::mat4& model);
+
+/**
+ * Per-object transforms and material indices in a storage buffer bound to OBJECT_DATA_BINDING, so drawing an object
+ * takes no uniform uploads. Normal matrices are computed here once per change rather than per vertex.
+ *
+ * Changes are collected on the CPU and update() uploads only the range between the first and last dirty object;
+ * objects that keep still cost nothing after their first frame. Index i is read by draws with
+ * gl_BaseInstance + gl_InstanceID == i, see MeshLibrary::drawObjects.
+ */
+class ObjectBuffer {
+public:
+    explicit ObjectBuffer(std::size_t capacity = 1024);
+
+    /** Append an object, returning its index */
+    std::uint32_t add(const glm::mat4& model, std::uint32_t materialIndex = 0);
+    void setModel(std::uint32_t index, const glm::mat4& model);
+    void setMaterial(std::uint32_t index, std::uint32_t materialIndex);
+    void clear();
+
+    /** Upload the dirty range, growing the buffer when objects were added past its capacity, then bind it */
+    void update();
+
+    [[nodiscard]] std::size_t size() const { return objects.size(); }
+    [[nodiscard]] const ObjectData& operator[](const std::uint32_t index) const { return objects[index]; }
+    /** Bytes written by the last update(), 0 when nothing changed */
+    [[nodiscard]] std::size_t getUploadedBytes() const { return uploadedBytes; }
+
+private:
+    void markDirty(std::uint32_t index);
+
+    std::vector<ObjectData> objects;
+    Buffer buffer;
+
+    // [dirtyBegin, dirtyEnd) needs uploading; empty when equal
+    std::uint32_t dirtyBegin = 0;
+    std::uint32_t dirtyEnd = 0;
+    std::size_t uploadedBytes = 0;
+};
@@ -0,0 +1,78 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Two-level segregated fit (TLSF) allocator over an abstract range of units; it never touches memory, so it can
+ * manage GPU buffers. Free blocks sit in bins keyed by a 5-bit exponent and 3-bit mantissa of their size, found
+ * through a bitmask, so allocate() and free() take constant time. Freed blocks merge with free neighbours at once.
+ */
+class OffsetAllocator {
+public:
+    static constexpr std::uint32_t NO_SPACE = 0xFFFFFFFFu;
+
+    struct Allocation {
+        std::uint32_t offset = NO_SPACE;
+        // block handle for free()
+        std::uint32_t node = NO_SPACE;
+
+        [[nodiscard]] bool valid() const { return offset != NO_SPACE; }
+    };
+
+    explicit OffsetAllocator(std::uint32_t size);
+
+    /** An invalid Allocation when no free block is large enough */
+    [[nodiscard]] Allocation allocate(std::uint32_t size);
+    void free(Allocation allocation);
+
+    /** Extend the range to newSize units; existing allocations keep their offsets */
+    void grow(std::uint32_t newSize);
+
+    [[nodiscard]] std::uint32_t getSize() const { return size; }
+    [[nodiscard]] std::uint32_t getFreeSize() const { return freeSize; }
+    [[nodiscard]] std::uint32_t getLargestFree() const;
+
+private:
+    static constexpr std::uint32_t MANTISSA_BITS = 3;
+    static constexpr std::uint32_t BIN_COUNT = 256;
+
+    struct Node {
+        std::uint32_t offset = 0;
+        std::uint32_t size = 0;
+        // neighbours in address order
+        std::uint32_t previous = NO_SPACE;
+        std::uint32_t next = NO_SPACE;
+        // neighbours in the same bin, while free
+        std::uint32_t previousFree = NO_SPACE;
+        std::uint32_t nextFree = NO_SPACE;
+        bool free = false;
+    };
+
+    /** Bin holding blocks of at least size units, rounding down; for filing free blocks */
+    static std::uint32_t binRoundDown(std::uint32_t size);
+    /** Smallest bin whose every block holds size units; for searching */
+    static std::uint32_t binRoundUp(std::uint32_t size);
+
+    std::uint32_t createNode(std::uint32_t offset, std::uint32_t size);
+    void insertFree(std::uint32_t node);
+    void removeFree(std::uint32_t node);
+    void releaseNode(std::uint32_t node);
+    std::uint32_t findBin(std::uint32_t first) const;
+
+    std::uint32_t size;
+    std::uint32_t freeSize = 0;
+
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> unusedNodes;
+    // the block at the highest address, which grow() extends
+    std::uint32_t last = NO_SPACE;
+
+    std::array<std::uint32_t, BIN_COUNT> binHeads{};
+    std::array<std::uint64_t, BIN_COUNT / 64> binMask{};
+};
@@ -0,0 +1,103 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "mesh.h"
+#include "mesh_library.h"
+#include "vertex_format.h"
+
+enum class PrimitiveType : std::uint8_t {
+    // XZ square facing +Y, one texture across the whole plane
+    Plane,
+    // the same square with the texture repeated once per cell, for floors in stress scenes
+    Grid,
+    // UV sphere, as primitives::sphere
+    Sphere,
+    // ring around +Y with its tube of minorRadius, outer edge at 0.5
+    Torus,
+};
+
+/**
+ * One procedural mesh: columns x rows quads, which are subdivisions along X and Z for planes and grids, segments
+ * and rings for spheres, and segments around the ring and around the tube for tori. Every mesh fits the unit cube
+ * [-0.5, 0.5] like the other primitives.
+ */
+struct PrimitiveDesc {
+    PrimitiveType type = PrimitiveType::Sphere;
+    std::uint32_t columns = 32;
+    std::uint32_t rows = 16;
+    // torus only
+    float minorRadius = 0.0f;
+
+    static constexpr PrimitiveDesc plane(const std::uint32_t subdivisions) {
+        return {PrimitiveType::Plane, subdivisions, subdivisions};
+    }
+    static constexpr PrimitiveDesc grid(const std::uint32_t columns, const std::uint32_t rows) {
+        return {PrimitiveType::Grid, columns, rows};
+    }
+    static constexpr PrimitiveDesc sphere(const std::uint32_t segments, const std::uint32_t rings) {
+        return {PrimitiveType::Sphere, segments, rings};
+    }
+    static constexpr PrimitiveDesc torus(const std::uint32_t segments, const std::uint32_t sides, const float minorRadius = 0.15f) {
+        return {PrimitiveType::Torus, segments, sides, minorRadius};
+    }
+
+    bool operator==(const PrimitiveDesc&) const = default;
+};
+
+namespace procedural {
+    /**
+     * Generate desc as an indexed, optimized mesh. All four types are lattices whose vertices are separable into a
+     * row and a column term, so the trigonometry is one table per axis and the vertices are computed four columns at
+     * a time with SSE (plain floats where SSE2 isn't available) into one array per component, which is interleaved
+     * into Vertex only at the end. mesh_optimizer then orders the triangles for the vertex cache.
+     */
+    [[nodiscard]] MeshData generate(const PrimitiveDesc& desc);
+}
+
+/** Lookups of a PrimitiveCache; hits cost a hash lookup, misses a generate and an upload */
+struct PrimitiveCacheStats {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    double generateMs = 0.0;
+    double uploadMs = 0.0;
+};
+
+/**
+ * Procedural meshes memoized by description and vertex format: the first get generates and adds the mesh to the
+ * MeshLibrary, every later one returns the same Mesh, which is to say the same range of the GPU buffers.
+ */
+class PrimitiveCache {
+public:
+    explicit PrimitiveCache(MeshLibrary& library);
+
+    PrimitiveCache(const PrimitiveCache&) = delete;
+    PrimitiveCache& operator=(const PrimitiveCache&) = delete;
+
+    const Mesh& get(const PrimitiveDesc& desc, VertexFormat format = {});
+
+    [[nodiscard]] std::size_t size() const { return meshes.size(); }
+    [[nodiscard]] const PrimitiveCacheStats& getStats() const { return stats; }
+
+private:
+    struct Key {
+        PrimitiveDesc desc;
+        std::uint32_t format;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    MeshLibrary& library;
+    std::unordered_map<Key, const Mesh*, KeyHash> meshes;
+    PrimitiveCacheStats stats;
+};
@@ -0,0 +1,49 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <string_view>
+#include <glad/glad.h>
+
+struct ProgramCacheStats {
+    unsigned int hits = 0;
+    unsigned int misses = 0;
+    unsigned int rejected = 0;
+    double loadMs = 0.0;    // time spent in glProgramBinary on hits
+    double compileMs = 0.0; // time spent compiling on misses
+    double savedMs = 0.0;   // recorded compile time of every hit, minus its load time
+};
+
+/**
+ * On-disk cache of linked program binaries (glGetProgramBinary / glProgramBinary).
+ * Entries are keyed by the shader sources plus the GL vendor, renderer and version strings, so a driver update
+ * simply misses. A blob the driver rejects is deleted and the caller falls back to a regular compile.
+ */
+class ProgramBinaryCache {
+public:
+    static void setDirectory(const std::filesystem::path& path);
+    static void setEnabled(bool value);
+
+    [[nodiscard]] static std::uint64_t makeKey(std::initializer_list<std::string_view> sources);
+
+    /** Try to fill program from the cache; returns false on a miss or rejected blob */
+    static bool load(GLuint program, std::uint64_t key);
+    /** Store the binary of a freshly linked program, along with how long building it took */
+    static void store(GLuint program, std::uint64_t key, double compileMs);
+
+    [[nodiscard]] static const ProgramCacheStats& getStats() { return stats; }
+
+private:
+    static inline std::filesystem::path directory = "cache/programs";
+    static inline bool enabled = true;
+    static inline int supported = -1; // -1 until the driver has been asked for binary formats
+    static inline ProgramCacheStats stats{};
+
+    static bool isAvailable();
+    static std::filesystem::path pathFor(std::uint64_t key);
+};
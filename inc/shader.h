@@ -4,36 +4,138 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include "shader_stage.h"
+#include "uniform.h"
+#include "uniform_table.h"
+
+// Blocking builds are ready when the constructor returns; Async builds only queue the work with the driver
+enum class ShaderBuild { Blocking, Async };
+
+/**
+ * A vertex and a fragment stage combined in a program pipeline. The stages are separable programs shared through
+ * ShaderStage, so pairing a common vertex shader with several fragment shaders compiles it once, and switching
+ * materials only swaps the fragment stage. Uniform setters look the name up in each stage.
+ */
 class Shader {
 public:
-    unsigned int program;
+    unsigned int pipeline = 0;
 
-    Shader(const char* vertexPath, const char* fragmentPath);
+    /** defines holds "#define NAME" lines injected into both stages, see ShaderLibrary for the usual way to get them */
+    Shader(const char* vertexPath, const char* fragmentPath, ShaderBuild mode = ShaderBuild::Blocking, std::string defines = {});
     ~Shader();
 
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
+    /** Let the driver compile on its own threads (GL_KHR_parallel_shader_compile); call once after loading GL */
+    static bool enableParallelCompile() { return ShaderStage::enableParallelCompile(); }
+
+    /** Non-blocking once parallel compile is enabled: finishes the build only when the driver reports completion */
+    ShaderStatus poll() const;
+    [[nodiscard]] bool ready() const { return poll() == ShaderStatus::Ready; }
+    void wait() const;
+
+    /** Rebuild from the original source files; on failure the current program stays in use */
+    bool reload();
+    /** Bumped by every successful reload; Uniform<T> handles resolved before that must be resolved again */
+    [[nodiscard]] unsigned int getGeneration() const { return generation; }
+    /** Every file this program was built from, including everything pulled in through #include */
+    [[nodiscard]] const std::vector<std::string>& getDependencies() const { return dependencies; }
+
+    /** The separable program behind GL_VERTEX_SHADER or GL_FRAGMENT_SHADER, for code that talks to GL directly */
+    [[nodiscard]] GLuint getStageProgram(GLenum stage) const;
+
     void use() const;
 
-    void setBool(const std::string& name, bool value) const;
-    void setInt(const std::string& name, int value) const;
-    void setFloat(const std::string& name, float value) const;
+    // setters go through glProgramUniform*, so they no longer depend on which program is bound
+    void setBool(std::string_view name, bool value) const;
+    void setInt(std::string_view name, int value) const;
+    void setFloat(std::string_view name, float value) const;
 
-    void setVec2(const std::string &name, const glm::vec2 &value) const;
-    void setVec2(const std::string &name, float x, float y) const;
+    void setVec2(std::string_view name, const glm::vec2 &value) const;
+    void setVec2(std::string_view name, float x, float y) const;
 
-    void setVec3(const std::string &name, const glm::vec3 &value) const;
-    void setVec3(const std::string &name, float x, float y, float z) const;
+    void setVec3(std::string_view name, const glm::vec3 &value) const;
+    void setVec3(std::string_view name, float x, float y, float z) const;
 
-    void setVec4(const std::string &name, const glm::vec4 &value) const;
-    void setVec4(const std::string &name, float x, float y, float z, float w) const;
+    void setVec4(std::string_view name, const glm::vec4 &value) const;
+    void setVec4(std::string_view name, float x, float y, float z, float w) const;
 
-    void setMat2(const std::string &name, const glm::mat2 &mat) const;
-    void setMat3(const std::string &name, const glm::mat3 &mat) const;
-    void setMat4(const std::string &name, const glm::mat4 &mat) const;
+    void setMat2(std::string_view name, const glm::mat2 &mat) const;
+    void setMat3(std::string_view name, const glm::mat3 &mat) const;
+    void setMat4(std::string_view name, const glm::mat4 &mat) const;
+
+    /** Location in the first stage that declares name, or -1 when the linker optimised it out */
+    [[nodiscard]] GLint getUniformLocation(std::string_view name) const;
+    [[nodiscard]] std::size_t getUniformCount() const;
+
+    /**
+     * Resolve a typed handle once; debug builds verify T against the GLSL declaration. A name declared in both
+     * stages resolves to the vertex stage, the string setters reach both.
+     */
+    template<typename T>
+    [[nodiscard]] Uniform<T> uniform(const UniformName name) const {
+        wait();
+        for (ShaderStage* stage : stages()) {
+            UniformTable& table = stage->getUniforms();
+            const UniformInfo* info = table.find(name.hash, name.name);
+            if (!info)
+                continue;
+#ifndef NDEBUG
+            if (!UniformTraits<T>::accepts(info->type))
+                reportTypeMismatch(name.name, info->type);
+#endif
+            return {stage->program, info->location, &table, info->shadowIndex};
+        }
+        return {};
+    }
 
 private:
-    static void checkCompileErrors(GLint shader, const std::string &type);
+    // build state is finished lazily by const accessors, hence mutable
+    mutable ShaderStatus status = ShaderStatus::Pending;
+    std::shared_ptr<ShaderStage> vertex;
+    std::shared_ptr<ShaderStage> fragment;
+
+    std::string vertexPath;
+    std::string fragmentPath;
+    std::string defines;
+    std::vector<std::string> dependencies;
+    unsigned int generation = 1;
+
+    [[nodiscard]] std::array<ShaderStage*, 2> stages() const { return {vertex.get(), fragment.get()}; }
+    void finishBuild() const;
+
+    /**
+     * Upload through the shadow copy of every stage declaring name, skipping values it already holds; debug builds
+     * verify T against the GLSL declaration like uniform<T>() and never upload a mismatched value
+     */
+    template<typename T>
+    void upload(const std::string_view name, const T& value) const {
+        if (status == ShaderStatus::Pending)
+            wait();
+
+        for (ShaderStage* stage : stages()) {
+            UniformTable& table = stage->getUniforms();
+            const UniformInfo* info = table.find(name);
+#ifndef NDEBUG
+            if (info && !UniformTraits<T>::accepts(info->type)) {
+                reportTypeMismatch(name, info->type);
+                continue;
+            }
+#endif
+            if (info && table.changed(*info, value))
+                UniformTraits<T>::set(stage->program, info->location, value);
+        }
+    }
+
+    static void reportTypeMismatch(std::string_view name, GLenum glslType);
 };
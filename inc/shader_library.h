@@ -0,0 +1,94 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "shader.h"
+
+class ShaderWatcher;
+
+// optional code paths of the material shaders; each bit becomes a #define of the same name
+enum ShaderFeature : std::uint32_t {
+    HAS_TINT = 1u << 0,
+    HAS_SPECULAR = 1u << 1,
+    HAS_EMISSION = 1u << 2,
+    // vertex stage reads InstanceTransforms for MeshLibrary::drawInstanced instead of the model uniform
+    INSTANCED = 1u << 3,
+    // together with INSTANCED: per-draw mesh data indexed by gl_DrawID, for DrawList
+    MULTI_DRAW = 1u << 4,
+    // vertex stage reads the object's ObjectData by gl_BaseInstance + gl_InstanceID, for MeshLibrary::drawObjects
+    OBJECT_DATA = 1u << 5,
+    // tangent-space normal map in material.normal; the mesh's VertexFormat needs a tangent
+    HAS_NORMAL_MAP = 1u << 6,
+};
+
+constexpr std::array<std::string_view, 7> SHADER_FEATURE_NAMES = {
+    "HAS_TINT", "HAS_SPECULAR", "HAS_EMISSION", "INSTANCED", "MULTI_DRAW", "OBJECT_DATA", "HAS_NORMAL_MAP"
+};
+
+/** A set of ShaderFeature bits, written as {HAS_TINT, HAS_SPECULAR} at call sites */
+struct ShaderFeatures {
+    std::uint32_t mask = 0;
+
+    constexpr ShaderFeatures() = default;
+    constexpr ShaderFeatures(const ShaderFeature feature) : mask(feature) {}
+    constexpr ShaderFeatures(const std::initializer_list<ShaderFeature> features) {
+        for (const ShaderFeature feature : features)
+            mask |= feature;
+    }
+
+    [[nodiscard]] constexpr bool has(const ShaderFeature feature) const { return (mask & feature) != 0; }
+};
+
+/**
+ * Named shader programs and their feature permutations. add() only records the source files; get() builds a
+ * permutation the first time it is asked for, with the requested features #defined, and hands out the same
+ * program for every later request with the same bitmask. Every material thereby runs the cheapest variant it
+ * needs without a hand-maintained copy of the shader.
+ *
+ * Programs live as long as the library, so keep it inside the scope that owns the GL context.
+ */
+class ShaderLibrary {
+public:
+    /** Variants are registered with watcher as they are built, when given */
+    explicit ShaderLibrary(ShaderWatcher* watcher = nullptr);
+    ~ShaderLibrary();
+
+    ShaderLibrary(const ShaderLibrary&) = delete;
+    ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
+    void add(std::string_view name, std::string vertexPath, std::string fragmentPath, ShaderBuild mode = ShaderBuild::Async);
+
+    /** The permutation of name with exactly these features, or nullptr when name was never added */
+    [[nodiscard]] Shader* get(std::string_view name, ShaderFeatures features = {});
+
+    [[nodiscard]] std::size_t getVariantCount() const { return variants.size(); }
+
+    /** The #define block for a feature set, in bit order so equal masks always give identical source */
+    [[nodiscard]] static std::string definesFor(ShaderFeatures features);
+
+private:
+    struct Source {
+        std::string vertexPath;
+        std::string fragmentPath;
+        ShaderBuild mode;
+    };
+
+    ShaderWatcher* watcher;
+
+    // name hash -> index into sources
+    std::unordered_map<std::uint64_t, std::uint32_t> names;
+    std::vector<Source> sources;
+    // (source index << 32) | feature mask -> built program
+    std::unordered_map<std::uint64_t, std::unique_ptr<Shader>> variants;
+};
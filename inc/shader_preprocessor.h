@@ -0,0 +1,53 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct PreprocessedSource {
+    std::string code;
+    // canonical path of every file that went into code; the index is the source string number used in #line
+    std::vector<std::string> files;
+};
+
+/**
+ * Expands #include "file" directives in GLSL, relative to the including file. Files marked with #pragma once are
+ * pasted at most once per expanded source; classic #ifndef guards work as usual since GLSL has a preprocessor.
+ *
+ * Every file is read and split into text and include segments once per run and kept in a shared cache, so a header
+ * used by twenty programs is only touched once. invalidate() drops a single file after it changed on disk.
+ *
+ * defines, a block of "#define NAME" lines, is pasted right below #version, which must stay the first line. Names
+ * the expanded source never mentions are left out.
+ */
+class ShaderPreprocessor {
+public:
+    [[nodiscard]] static PreprocessedSource expand(const std::string& path, std::string_view defines = {});
+    static void invalidate(const std::string& path);
+
+    [[nodiscard]] static std::string canonicalPath(const std::string& path);
+
+private:
+    struct Segment {
+        std::string text;    // raw text, or
+        std::string include; // canonical path of an included file
+        int line = 1;        // line of the including file this segment starts on
+    };
+
+    struct Chunk {
+        std::vector<Segment> segments;
+        bool once = false;
+        bool found = false;
+    };
+
+    static inline std::unordered_map<std::string, Chunk> chunks;
+
+    static const Chunk& load(const std::string& file);
+    static void expandInto(const std::string& file, PreprocessedSource& out, std::unordered_set<std::string>& included, int depth);
+};
@@ -0,0 +1,70 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glad/glad.h>
+
+#include "shader_preprocessor.h"
+#include "uniform_table.h"
+
+enum class ShaderStatus { Pending, Ready, Failed };
+
+/**
+ * One stage linked on its own as a separable program (GL_ARB_separate_shader_objects). Stages are shared: every
+ * Shader whose stage expands to the same source gets the same ShaderStage, so a common vertex shader is compiled
+ * and linked once no matter how many fragment shaders it is paired with. The uniforms and their shadows belong to
+ * the stage for the same reason.
+ */
+class ShaderStage {
+public:
+    GLuint program = 0;
+
+    /** The stage for this exact source, built on first request and alive while any Shader still uses it */
+    [[nodiscard]] static std::shared_ptr<ShaderStage> get(GLenum type, PreprocessedSource source);
+
+    /** Let the driver compile on its own threads (GL_KHR_parallel_shader_compile); call once after loading GL */
+    static bool enableParallelCompile();
+
+    ShaderStage(GLenum type, PreprocessedSource source, std::uint64_t cacheKey);
+    ~ShaderStage();
+
+    ShaderStage(const ShaderStage&) = delete;
+    ShaderStage& operator=(const ShaderStage&) = delete;
+
+    /** Non-blocking once parallel compile is enabled: finishes the build only when the driver reports completion */
+    ShaderStatus poll();
+    void wait();
+
+    [[nodiscard]] UniformTable& getUniforms() { return uniforms; }
+    [[nodiscard]] const std::vector<std::string>& getFiles() const { return files; }
+    [[nodiscard]] GLenum getType() const { return type; }
+
+    /** Stages currently alive, each compiled once however many pipelines share it */
+    [[nodiscard]] static std::size_t getLiveCount();
+
+private:
+    static inline bool parallelCompile = false;
+    // expanded source key -> stage; entries expire with the last Shader using them
+    static inline std::unordered_map<std::uint64_t, std::weak_ptr<ShaderStage>> stages;
+
+    GLenum type;
+    ShaderStatus status = ShaderStatus::Pending;
+    GLuint pendingShader = 0;
+    std::uint64_t cacheKey;
+    std::chrono::steady_clock::time_point buildStart;
+    // in source string order, so #line numbers in driver errors can be mapped back to files
+    std::vector<std::string> files;
+    UniformTable uniforms;
+
+    void finishBuild();
+
+    static bool checkCompileErrors(GLuint object, const char* type, const std::vector<std::string>* files = nullptr);
+};
@@ -0,0 +1,60 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "shader.h"
+
+/**
+ * Watches the source files of registered shaders from a background thread (inotify on Linux) and rebuilds the
+ * affected programs when poll() is called on the GL thread. Directories are watched rather than files, so editors
+ * that save through a rename are picked up as well. On other platforms watching is a no-op.
+ *
+ * Programs load the copies of resources/ the build places next to the executable. When the build passes
+ * RESOURCE_SOURCE_DIR and RESOURCE_DEST_DIR, the source-tree file behind such a copy is watched instead, and an
+ * edit is copied over the build copy before the program is rebuilt, so saving in the source tree is enough.
+ */
+class ShaderWatcher {
+public:
+    ShaderWatcher();
+    ~ShaderWatcher();
+
+    ShaderWatcher(const ShaderWatcher&) = delete;
+    ShaderWatcher& operator=(const ShaderWatcher&) = delete;
+
+    void watch(Shader& shader);
+    void unwatch(const Shader& shader);
+
+    /** Call once per frame on the GL thread; returns how many programs were rebuilt */
+    unsigned int poll();
+
+private:
+    // GL thread only: canonical source path -> shaders built from it
+    std::unordered_map<std::string, std::vector<Shader*>> dependents;
+    // GL thread only: watched source-tree file -> the build copy shaders load
+    std::unordered_map<std::string, std::string> copies;
+
+    // shared with the watcher thread
+    std::atomic<bool> changed{false};
+    std::mutex mutex;
+    std::unordered_set<std::string> watchedFiles;
+    std::unordered_map<int, std::string> watchedDirectories;
+    std::unordered_set<std::string> changedFiles;
+
+    int inotifyFd = -1;
+    int wakeFd = -1;
+    std::thread thread;
+
+    std::string watchedPathFor(const std::string& file);
+    void addWatch(const std::string& file);
+    void run();
+};
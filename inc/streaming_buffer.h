@@ -0,0 +1,79 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "gl_objects.h"
+
+/** Space handed out by StreamingBuffer::allocate; data is nullptr when the region was full */
+struct StreamAllocation {
+    void* data = nullptr;
+    // from the start of the buffer, for binding ranges and indirect / attribute offsets
+    GLintptr offset = 0;
+    GLsizeiptr size = 0;
+};
+
+/**
+ * Ring of per-frame regions in one persistently mapped, coherent buffer (glBufferStorage with
+ * GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT). Data is written straight into the mapping, so there is no copy and
+ * no glBufferSubData the driver might have to synchronise.
+ *
+ * beginFrame() fences the region just used, which is why it must come after the last command reading that
+ * region, and moves on to the oldest one, waiting only if the GPU is still reading it. Allocations are valid until
+ * the next beginFrame().
+ */
+class StreamingBuffer {
+public:
+    explicit StreamingBuffer(GLsizeiptr regionSize, std::size_t regionCount = 3);
+    ~StreamingBuffer();
+
+    StreamingBuffer(const StreamingBuffer&) = delete;
+    StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+    void beginFrame();
+
+    /**
+     * Make every region hold at least size bytes. Growing waits for the GPU to finish with the old buffer and drops
+     * this frame's allocations, so reserve before allocating.
+     */
+    void reserve(GLsizeiptr size);
+
+    /** size bytes at a multiple of alignment, which has to be a power of two no larger than 256 */
+    [[nodiscard]] StreamAllocation allocate(GLsizeiptr size, GLsizeiptr alignment = 16);
+
+    /** Copy data into a fresh allocation */
+    template<typename T>
+    StreamAllocation write(const std::span<const T> data, const GLsizeiptr alignment = alignof(T)) {
+        const StreamAllocation allocation = allocate(static_cast<GLsizeiptr>(data.size_bytes()), alignment);
+        if (allocation.data)
+            std::copy(data.begin(), data.end(), static_cast<T*>(allocation.data));
+        return allocation;
+    }
+
+    [[nodiscard]] const Buffer& getBuffer() const { return buffer; }
+    [[nodiscard]] GLsizeiptr getRegionSize() const { return regionSize; }
+    /** Times beginFrame() had to wait for the GPU; more than zero means more regions are needed */
+    [[nodiscard]] unsigned int getStalls() const { return stalls; }
+
+private:
+    void create(GLsizeiptr size);
+    void waitForRegion(std::size_t index);
+
+    Buffer buffer;
+    std::byte* mapping = nullptr;
+    GLsizeiptr regionSize = 0;
+
+    // one fence per region, null when the GPU has nothing pending on it
+    std::vector<GLsync> fences;
+    std::size_t region = 0;
+    GLsizeiptr used = 0;
+    unsigned int stalls = 0;
+};
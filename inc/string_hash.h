@@ -0,0 +1,21 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// 64-bit FNV-1a, used to key uniform names and other short identifiers
+// ---------------------------------------------------------------------------------------------------------------------
+constexpr std::uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+constexpr std::uint64_t FNV_PRIME = 0x100000001b3ull;
+
+constexpr std::uint64_t hashString(const std::string_view str, std::uint64_t hash = FNV_OFFSET_BASIS) {
+    for (const char c : str) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
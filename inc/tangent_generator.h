@@ -0,0 +1,28 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "mesh.h"
+#include "thread_pool.h"
+
+/**
+ * Per-vertex tangents following the MikkTSpace conventions (Mikkelsen 2008), so normal maps baked by the usual tools
+ * shade without seams: each triangle's texture-space direction of +u is projected onto the plane of the vertex
+ * normal and averaged with the corner angle as weight, and w is the sign that rebuilds the bitangent as
+ * w * cross(normal, tangent.xyz).
+ *
+ * Runs in two passes over pool: triangle ranges compute their texture-space frames, then vertex ranges gather the
+ * triangles around each vertex in index order. Every sum is taken in the same order whatever the thread count, so
+ * the result is bit-identical from run to run. Where triangles sharing a vertex disagree on the UV orientation
+ * (a mirrored seam that was welded) the vertex follows the larger share; MikkTSpace would split it.
+ */
+[[nodiscard]] std::vector<glm::vec4> generateTangents(std::span<const Vertex> vertices,
+                                                      std::span<const std::uint32_t> indices, ThreadPool& pool);
@@ -0,0 +1,57 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Fixed set of worker threads taking jobs from one queue. Meant for short CPU-bound batches such as parsing a file
+ * in chunks; jobs must not wait on other jobs of the same pool.
+ */
+class ThreadPool {
+public:
+    /** 0 picks one thread per hardware thread */
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template<typename F>
+    auto submit(F&& job) -> std::future<std::invoke_result_t<F>> {
+        // packaged_task is move-only and std::function wants copies, so the queue holds it through a shared_ptr
+        auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(job));
+        auto future = task->get_future();
+        {
+            std::lock_guard lock(mutex);
+            jobs.emplace([task] { (*task)(); });
+        }
+        wake.notify_one();
+        return future;
+    }
+
+    /** Split [0, count) into about four ranges per worker, run job(begin, end) on each and wait for all of them */
+    void parallelFor(std::size_t count, const std::function<void(std::size_t begin, std::size_t end)>& job);
+
+    [[nodiscard]] std::size_t getThreadCount() const { return workers.size(); }
+
+private:
+    void run();
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+};
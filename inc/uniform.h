@@ -0,0 +1,145 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "string_hash.h"
+#include "uniform_table.h"
+
+/**
+ * A uniform name whose hash is computed by the compiler. Only string literals convert to it, so resolving a
+ * handle never hashes at runtime.
+ */
+struct UniformName {
+    std::uint64_t hash;
+    std::string_view name;
+
+    template<std::size_t N>
+    consteval UniformName(const char (&str)[N]) : hash(hashString({str, N - 1})), name(str, N - 1) {}
+};
+
+// maps a C++ value type to its glProgramUniform* call and to the GLSL types it may feed
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename T>
+struct UniformTraits;
+
+template<>
+struct UniformTraits<bool> {
+    static void set(const GLuint program, const GLint location, const bool value) {
+        glProgramUniform1i(program, location, static_cast<int>(value));
+    }
+    static constexpr bool accepts(const GLenum type) { return type == GL_BOOL; }
+};
+
+template<>
+struct UniformTraits<int> {
+    static void set(const GLuint program, const GLint location, const int value) {
+        glProgramUniform1i(program, location, value);
+    }
+    // samplers are bound to texture units through plain ints
+    static constexpr bool accepts(const GLenum type) {
+        return type == GL_INT || type == GL_BOOL || type == GL_SAMPLER_2D || type == GL_SAMPLER_3D
+            || type == GL_SAMPLER_CUBE || type == GL_SAMPLER_2D_ARRAY || type == GL_SAMPLER_2D_SHADOW;
+    }
+};
+
+template<>
+struct UniformTraits<unsigned int> {
+    static void set(const GLuint program, const GLint location, const unsigned int value) {
+        glProgramUniform1ui(program, location, value);
+    }
+    static constexpr bool accepts(const GLenum type) { return type == GL_UNSIGNED_INT; }
+};
+
+template<>
+struct UniformTraits<float> {
+    static void set(const GLuint program, const GLint location, const float value) {
+        glProgramUniform1f(program, location, value);
+    }
+    static constexpr bool accepts(const GLenum type) { return type == GL_FLOAT; }
+};
+
+template<>
+struct UniformTraits<glm::vec2> {
+    static void set(const GLuint program, const GLint location, const glm::vec2& value) {
+        glProgramUniform2fv(program, location, 1, &value[0]);
+    }
+    static constexpr bool accepts(const GLenum type) { return type == GL_FLOAT_VEC2; }
+};
+
+template<>
+struct UniformTraits<glm::vec3> {
+    static void set(const GLuint program, const GLint location, const glm::vec3& value) {
+        glProgramUniform3fv(program, location, 1, &value[0]);
+    }
+    static constexpr bool accepts(const GLenum type) { return type == GL_FLOAT_VEC3; }
+};
+
+template<>
+struct UniformTraits<glm::vec4> {
+    static void set(const GLuint program, const GLint location, const glm::vec4& value) {
+        glProgramUniform4fv(program, location, 1, &value[0]);
+    }
+    static constexpr bool accepts(const GLenum type) { return type == GL_FLOAT_VEC4; }
+};
+
+template<>
+struct UniformTraits<glm::mat2> {
+    static void set(const GLuint program, const GLint location, const glm::mat2& value) {
+        glProgramUniformMatrix2fv(program, location, 1, GL_FALSE, &value[0][0]);
+    }
+    static constexpr bool accepts(const GLenum type) { return type == GL_FLOAT_MAT2; }
+};
+
+template<>
+struct UniformTraits<glm::mat3> {
+    static void set(const GLuint program, const GLint location, const glm::mat3& value) {
+        glProgramUniformMatrix3fv(program, location, 1, GL_FALSE, &value[0][0]);
+    }
+    static constexpr bool accepts(const GLenum type) { return type == GL_FLOAT_MAT3; }
+};
+
+template<>
+struct UniformTraits<glm::mat4> {
+    static void set(const GLuint program, const GLint location, const glm::mat4& value) {
+        glProgramUniformMatrix4fv(program, location, 1, GL_FALSE, &value[0][0]);
+    }
+    static constexpr bool accepts(const GLenum type) { return type == GL_FLOAT_MAT4; }
+};
+
+/**
+ * Pre-resolved handle to a single uniform of a program. Resolve it once through Shader::uniform<T>() and
+ * set it as often as needed; setting is a single glProgramUniform* call and does not require the program to be bound.
+ * Values equal to the last upload are skipped through the program's shadow copy.
+ */
+template<typename T>
+class Uniform {
+    static_assert(sizeof(T) <= UniformTable::SHADOW_STRIDE, "uniform value does not fit its shadow");
+
+public:
+    Uniform() = default;
+    Uniform(const GLuint program, const GLint location, UniformTable* table, const std::uint32_t shadowIndex) :
+    program(program), location(location), table(table), shadowIndex(shadowIndex) {}
+
+    void set(const T& value) const {
+        if (!table || !table->changed(shadowIndex, &value, sizeof(T)))
+            return;
+        UniformTraits<T>::set(program, location, value);
+    }
+
+    /** false when the uniform is not active in the program; setting it is then a harmless no-op */
+    [[nodiscard]] bool valid() const { return location >= 0; }
+
+private:
+    GLuint program = 0;
+    GLint location = -1;
+    UniformTable* table = nullptr;
+    std::uint32_t shadowIndex = 0;
+};
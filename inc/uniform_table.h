@@ -0,0 +1,98 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glad/glad.h>
+
+#include "string_hash.h"
+
+struct UniformInfo {
+    std::uint64_t hash = 0;
+    GLint location = -1;
+    GLenum type = GL_NONE;
+    std::uint32_t nameOffset = 0;
+    std::uint32_t nameLength = 0;
+    // names that alias one location (array "x" and "x[0]") share a shadow
+    std::uint32_t shadowIndex = 0;
+};
+
+struct UniformUploadStats {
+    unsigned int uploads = 0;
+    unsigned int skipped = 0;
+};
+
+/**
+ * Flat open-addressing table of the active uniforms of a linked program. Built once after linking; lookups
+ * hash the name and probe a contiguous slot array, so no std::string is ever constructed on the hot path.
+ *
+ * Each location also keeps a CPU shadow of the last value uploaded to it, so setting an unchanged value costs a
+ * memcmp instead of a GL call.
+ */
+class UniformTable {
+public:
+    void build(GLuint program);
+    void clear();
+
+    [[nodiscard]] const UniformInfo* find(std::string_view name) const;
+    [[nodiscard]] const UniformInfo* find(std::uint64_t hash, std::string_view name) const;
+
+    [[nodiscard]] GLint location(const std::string_view name) const {
+        const UniformInfo* info = find(name);
+        return info ? info->location : -1;
+    }
+
+    /** Compare against and update the shadow of a location; false means the value is already on the GPU */
+    [[nodiscard]] bool changed(const std::uint32_t shadowIndex, const void* value, const std::size_t size) {
+        std::byte* stored = shadow.data() + static_cast<std::size_t>(shadowIndex) * SHADOW_STRIDE;
+        if (shadowValid[shadowIndex] && std::memcmp(stored, value, size) == 0) {
+            uploadStats.skipped++;
+            return false;
+        }
+
+        std::memcpy(stored, value, size);
+        shadowValid[shadowIndex] = true;
+        uploadStats.uploads++;
+        return true;
+    }
+
+    template<typename T>
+    [[nodiscard]] bool changed(const UniformInfo& info, const T& value) {
+        static_assert(sizeof(T) <= SHADOW_STRIDE, "uniform value does not fit its shadow");
+        return changed(info.shadowIndex, &value, sizeof(T));
+    }
+
+    /** Uploads and skips over every program since the previous call, which resets the counters */
+    static UniformUploadStats takeUploadStats() {
+        const UniformUploadStats stats = uploadStats;
+        uploadStats = {};
+        return stats;
+    }
+
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] std::string_view name(const UniformInfo& info) const {
+        return std::string_view(names).substr(info.nameOffset, info.nameLength);
+    }
+
+    // room for the largest value type, a mat4
+    static constexpr std::size_t SHADOW_STRIDE = 16 * sizeof(float);
+
+private:
+    std::vector<UniformInfo> slots;
+    std::string names;
+    std::size_t count = 0;
+
+    std::vector<std::byte> shadow;
+    std::vector<bool> shadowValid;
+
+    static inline UniformUploadStats uploadStats;
+
+    void insert(std::string_view name, GLint location, GLenum type, std::uint32_t shadowIndex);
+};
@@ -0,0 +1,105 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "mesh.h"
+
+class VertexArray;
+
+enum class PositionFormat : std::uint8_t {
+    Float,
+    // normalized shorts spanning the mesh bounds, see VertexQuantization
+    Snorm16,
+};
+
+enum class NormalFormat : std::uint8_t {
+    Float,
+    // signed normalized 10 bits per axis in one GL_INT_2_10_10_10_REV word
+    Int2_10_10_10,
+    // unit vector folded onto an octahedron, two normalized shorts; decoded in the vertex shader
+    Octahedral,
+};
+
+enum class TexCoordFormat : std::uint8_t {
+    Float,
+    Half,
+    // only for coordinates inside [0, 1], anything outside is clamped
+    Unorm16,
+};
+
+enum class TangentFormat : std::uint8_t {
+    // no tangent attribute; MeshData::tangents is ignored
+    None,
+    Float,
+    // xyz in signed normalized 10 bits, the bitangent sign in the 2-bit w
+    Int2_10_10_10,
+};
+
+/**
+ * How each attribute of a Vertex is stored on the GPU; the shader inputs stay at locations 0, 1 and 2, and the
+ * optional tangent from MeshData::tangents follows them at location 5
+ */
+struct VertexFormat {
+    PositionFormat position = PositionFormat::Float;
+    NormalFormat normal = NormalFormat::Float;
+    TexCoordFormat texCoords = TexCoordFormat::Float;
+    TangentFormat tangent = TangentFormat::None;
+
+    /** 16 bytes per vertex instead of 32 */
+    static constexpr VertexFormat compact() {
+        return {PositionFormat::Snorm16, NormalFormat::Octahedral, TexCoordFormat::Half};
+    }
+
+    [[nodiscard]] std::uint32_t positionSize() const;
+    [[nodiscard]] std::uint32_t normalSize() const;
+    [[nodiscard]] std::uint32_t texCoordSize() const;
+    [[nodiscard]] std::uint32_t tangentSize() const;
+    [[nodiscard]] std::uint32_t stride() const { return positionSize() + normalSize() + texCoordSize() + tangentSize(); }
+
+    /** Distinct for every combination, for keying one vertex array per format */
+    [[nodiscard]] std::uint32_t key() const;
+
+    /** Point attributes 0, 1, 2 and, with a tangent, 5 of vertexArray at buffer binding 0 in this layout */
+    void applyLayout(const VertexArray& vertexArray) const;
+};
+
+/** Undoes position quantization: position = offset + scale * stored; identity for float positions */
+struct VertexQuantization {
+    glm::vec3 positionScale{1.0f};
+    glm::vec3 positionOffset{0.0f};
+};
+
+/**
+ * Interleave vertices in format, appending to out; returns what the vertex shader needs to decode them. tangents
+ * holds one per vertex or is empty, in which case a format with a tangent gets +x everywhere.
+ */
+VertexQuantization encodeVertices(std::span<const Vertex> vertices, VertexFormat format, std::vector<std::byte>& out,
+                                  std::span<const glm::vec4> tangents = {});
+
+/**
+ * Per-instance placement read by INSTANCED vertex shaders at locations 3 and 4, in place of the model matrix.
+ * Translation, uniform scale and a rotation quaternion take 32 bytes where a mat4 takes 64.
+ */
+struct InstanceTransform {
+    glm::vec4 translationScale; // xyz translation, w uniform scale
+    glm::vec4 rotation;         // unit quaternion, xyz vector part and w scalar part
+
+    static InstanceTransform from(glm::vec3 translation, const glm::quat& rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+                                  float scale = 1.0f);
+
+    /** Point attributes 3 and 4 of vertexArray at binding, advancing once per instance */
+    static void applyLayout(const VertexArray& vertexArray, GLuint binding);
+};
+
+static_assert(sizeof(InstanceTransform) == 32);
@@ -0,0 +1,10 @@
+#pragma once
+
+// mirrors FrameData in inc/frame_data.h, uploaded once per frame by FrameUniforms
+layout (std140, binding = 0) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProj;
+    vec4 cameraPosition;
+    float time;
+} frame;
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "frame_data.glsl"
+
+struct Light {
+    vec3 position;
+
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+// classic Phong for a single point light; the colours are the surface terms each material samples on its own
+vec3 phong(Light light, vec3 lightPosition, vec3 normal, vec3 fragPos,
+           vec3 ambientColor, vec3 diffuseColor, vec3 specularColor, float shininess) {
+    vec3 norm = normalize(normal);
+    vec3 lightDir = normalize(lightPosition - fragPos);
+
+    // ambient
+    vec3 ambient = light.ambient * ambientColor;
+
+    // diffuse
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = light.diffuse * diff * diffuseColor;
+
+    // specular
+    vec3 viewDir = normalize(frame.cameraPosition.xyz - fragPos);
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    vec3 specular = light.specular * spec * specularColor;
+
+    return ambient + diffuse + specular;
+}
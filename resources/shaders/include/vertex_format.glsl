@@ -0,0 +1,42 @@
+#pragma once
+
+// dequantization of the compact vertex formats (vertex_format.h); MeshLibrary::draw sets these per mesh and the
+// initial values leave float meshes untouched
+uniform bool octahedralNormals = false;
+
+#ifdef MULTI_DRAW
+// one entry per indirect command, DrawList fills it and points firstDraw at the bucket being drawn
+struct DrawQuantization {
+    vec4 positionScale;  // w unused
+    vec4 positionOffset; // w unused
+};
+
+layout (std430, binding = 1) readonly buffer DrawData {
+    DrawQuantization drawQuantizations[];
+};
+
+uniform int firstDraw;
+
+vec3 decodePosition(vec3 position) {
+    DrawQuantization quantization = drawQuantizations[firstDraw + gl_DrawID];
+    return quantization.positionOffset.xyz + quantization.positionScale.xyz * position;
+}
+#else
+uniform vec3 positionScale = vec3(1.0);
+uniform vec3 positionOffset = vec3(0.0);
+
+vec3 decodePosition(vec3 position) {
+    return positionOffset + positionScale * position;
+}
+#endif
+
+vec3 decodeNormal(vec3 normal) {
+    if (!octahedralNormals)
+        return normal;
+
+    // unfold the octahedron: the lower hemisphere was mirrored over the diagonals
+    vec3 n = vec3(normal.xy, 1.0 - abs(normal.x) - abs(normal.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
@@ -1,10 +1,15 @@
 #version 460 core
 layout (location = 0) in vec3 aPos;
 
+out gl_PerVertex {
+    vec4 gl_Position;
+};
+
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+#include "../include/frame_data.glsl"
+#include "../include/vertex_format.glsl"
 
 void main() {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
-}
\ No newline at end of file
+    gl_Position = frame.viewProj * model * vec4(decodePosition(aPos), 1.0);
+}
@@ -1,8 +1,11 @@
 #version 460 core
+#include "../include/phong.glsl"
+
 out vec4 FragColor;
 
-in vec3 Normal;
-in vec3 FragPos;
+// matches the outputs of material.vert; TexCoords is simply not read
+layout (location = 0) in vec3 FragPos;
+layout (location = 1) in vec3 Normal;
 
 struct Material {
     vec3 ambient;
@@ -11,37 +14,13 @@ struct Material {
     float shininess;
 };
 
-struct Light{
-    vec3 position;
-
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-};
-
 uniform Material material;
 uniform Light light;
 
 uniform vec3 lightPos;
 uniform vec3 objectColor;
-uniform vec3 viewPos;
 
 void main() {
-    // ambient
-    vec3 ambient = light.ambient * material.ambient;
-
-    // diffuse
-    vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(lightPos - FragPos);
-    float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = light.diffuse * (diff * material.diffuse);
-
-    // specular
-    vec3 viewDir = normalize(viewPos - FragPos);
-    vec3 reflectDir = reflect(-lightDir, norm);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    vec3 specular = light.specular * (spec * material.specular);
-
-    vec3 result = ambient + diffuse + specular;
+    vec3 result = phong(light, lightPos, Normal, FragPos, material.ambient, material.diffuse, material.specular, material.shininess);
     FragColor = vec4(result, 1.0);
 }
\ No newline at end of file
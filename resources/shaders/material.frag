@@ -1,58 +1,81 @@
 #version 460 core
+#include "include/phong.glsl"
+
+// variants are built by ShaderLibrary, which defines any of
+//   HAS_TINT      blend material.color over the diffuse map
+//   HAS_SPECULAR  sample a specular map, otherwise material.specular is a constant colour
+//   HAS_EMISSION  add an emission map
+//   HAS_NORMAL_MAP  perturb the normal with a tangent-space normal map, the mesh needs tangents
+
 out vec4 FragColor;
 
 struct Material {
+#ifdef HAS_TINT
     vec3 color;
     float tintStrength;
+#endif
 
     sampler2D diffuse;
+#ifdef HAS_SPECULAR
     sampler2D specular;
+#else
+    vec3 specular;
+#endif
     float shininess;
 
+#ifdef HAS_EMISSION
     sampler2D emission;
     float emissionStrength;
-};
-
-struct Light{
-    vec3 position;
+#endif
 
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
+#ifdef HAS_NORMAL_MAP
+    sampler2D normal;
+#endif
 };
 
-in vec3 Normal;
-in vec3 FragPos;
-in vec2 TexCoords;
+layout (location = 0) in vec3 FragPos;
+layout (location = 1) in vec3 Normal;
+layout (location = 2) in vec2 TexCoords;
+#ifdef HAS_NORMAL_MAP
+layout (location = 4) in vec4 Tangent;
+#endif
 
 uniform Material material;
 uniform Light light;
 
-uniform vec3 viewPos;
-
 void main() {
-    // ambient
-    vec3 ambient = light.ambient * material.color * vec3(texture(material.diffuse, TexCoords));
-
-    // diffuse
-    vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(light.position - FragPos);
-    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 texColor = vec3(texture(material.diffuse, TexCoords));
 
+#ifdef HAS_TINT
     // mix diffuse texture colors with material
-    vec3 texColor = vec3(texture(material.diffuse, TexCoords));
-    vec3 finalColor = mix(texColor, texColor * material.color, material.tintStrength);
-    vec3 diffuse = light.diffuse * diff * finalColor;
+    vec3 ambientColor = material.color * texColor;
+    vec3 diffuseColor = mix(texColor, texColor * material.color, material.tintStrength);
+#else
+    vec3 ambientColor = texColor;
+    vec3 diffuseColor = texColor;
+#endif
+
+#ifdef HAS_SPECULAR
+    vec3 specularColor = vec3(texture(material.specular, TexCoords));
+#else
+    vec3 specularColor = material.specular;
+#endif
+
+#ifdef HAS_NORMAL_MAP
+    // MikkTSpace: the bitangent is rebuilt per pixel from the interpolated, unnormalized normal and tangent
+    vec3 bitangent = Tangent.w * cross(Normal, Tangent.xyz);
+    vec3 mapped = texture(material.normal, TexCoords).rgb * 2.0 - 1.0;
+    vec3 normal = mapped.x * Tangent.xyz + mapped.y * bitangent + mapped.z * Normal;
+#else
+    vec3 normal = Normal;
+#endif
 
-    // specular
-    vec3 viewDir = normalize(viewPos - FragPos);
-    vec3 reflectDir = reflect(-lightDir, norm);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
+    vec3 result = phong(light, light.position, normal, FragPos, ambientColor, diffuseColor, specularColor, material.shininess);
 
+#ifdef HAS_EMISSION
     // emmision
-    vec3 emission = texture(material.emission, TexCoords).rgb * material.emissionStrength;
+    result += texture(material.emission, TexCoords).rgb * material.emissionStrength;
+#endif
 
-    vec3 result = ambient + diffuse + specular + emission;
     FragColor = vec4(result, 1.0);
-}
\ No newline at end of file
+}
@@ -2,19 +2,77 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
+#ifdef HAS_NORMAL_MAP
+// MikkTSpace tangent (tangent_generator.h), w the bitangent's sign
+layout (location = 5) in vec4 aTangent;
+#endif
 
-out vec3 FragPos;
-out vec3 Normal;
-out vec2 TexCoords;
+// built as a separable stage and shared by every material fragment shader, so the interface is matched by location
+out gl_PerVertex {
+    vec4 gl_Position;
+};
 
+layout (location = 0) out vec3 FragPos;
+layout (location = 1) out vec3 Normal;
+layout (location = 2) out vec2 TexCoords;
+#ifdef HAS_NORMAL_MAP
+layout (location = 4) out vec4 Tangent;
+#endif
+
+#include "include/frame_data.glsl"
+#include "include/vertex_format.glsl"
+
+#if defined(OBJECT_DATA)
+// ObjectBuffer (object_buffer.h), one per object; the draw's baseInstance selects the first
+struct ObjectData {
+    mat4 model;
+    mat3 normalMatrix;
+    uint materialIndex;
+};
+
+layout (std430, binding = 2) readonly buffer Objects {
+    ObjectData objects[];
+};
+
+// for fragment stages that pick their material per object
+layout (location = 3) flat out uint MaterialIndex;
+#elif defined(INSTANCED)
+// InstanceTransform (vertex_format.h), one per instance
+layout (location = 3) in vec4 aTranslationScale;
+layout (location = 4) in vec4 aRotation;
+
+vec3 rotate(vec4 q, vec3 v) {
+    return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+#else
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// inverse transpose of model's upper 3x3, computed on the CPU; only needed when model rotates or scales
+uniform mat3 normalMatrix = mat3(1.0);
+#endif
 
 void main() {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = aNormal;
+#if defined(OBJECT_DATA)
+    ObjectData object = objects[gl_BaseInstance + gl_InstanceID];
+    FragPos = vec3(object.model * vec4(decodePosition(aPos), 1.0));
+    Normal = object.normalMatrix * decodeNormal(aNormal);
+    MaterialIndex = object.materialIndex;
+#ifdef HAS_NORMAL_MAP
+    Tangent = vec4(mat3(object.model) * aTangent.xyz, aTangent.w);
+#endif
+#elif defined(INSTANCED)
+    FragPos = aTranslationScale.xyz + aTranslationScale.w * rotate(aRotation, decodePosition(aPos));
+    Normal = rotate(aRotation, decodeNormal(aNormal));
+#ifdef HAS_NORMAL_MAP
+    Tangent = vec4(rotate(aRotation, aTangent.xyz), aTangent.w);
+#endif
+#else
+    FragPos = vec3(model * vec4(decodePosition(aPos), 1.0));
+    Normal = normalMatrix * decodeNormal(aNormal);
+#ifdef HAS_NORMAL_MAP
+    Tangent = vec4(mat3(model) * aTangent.xyz, aTangent.w);
+#endif
+#endif
     TexCoords = aTexCoords;
 
-    gl_Position = projection * view * vec4(FragPos, 1.0);
-}
\ No newline at end of file
+    gl_Position = frame.viewProj * vec4(FragPos, 1.0);
+}
@@ -21,6 +21,10 @@ glm::mat4 Camera::GetViewMatrix() const {
     return lookAt(Position, Position + Front, Up);
 }
 
+glm::mat4 Camera::GetProjectionMatrix(const float aspectRatio, const float nearPlane, const float farPlane) const {
+    return glm::perspective(glm::radians(Zoom), aspectRatio, nearPlane, farPlane);
+}
+
 void Camera::ProcessKeyboard(const Camera_Movement direction, const float deltaTime) {
     const float velocity = MovementSpeed * deltaTime;
     if (direction == FORWARD)
@@ -0,0 +1,117 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "draw_list.h"
+
+#include <algorithm>
+#include <span>
+
+#include "gl_state.h"
+#include "shader.h"
+
+namespace {
+    GLuint indexSize(const GLenum indexType) {
+        return indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+    }
+
+    GLsizeiptr getAlignment(const GLenum name) {
+        GLint alignment = 0;
+        glGetIntegerv(name, &alignment);
+        return alignment;
+    }
+}
+
+// room for a few thousand objects before the first grow
+DrawList::DrawList(MeshLibrary& meshes) : meshes(meshes), stream(256 * 1024) {}
+
+void DrawList::add(const Shader& shader, const Mesh& mesh, const InstanceTransform& transform) {
+    const auto bucket = std::ranges::find_if(buckets, [&](const Bucket& candidate) {
+        return candidate.shader == &shader && candidate.formatKey == mesh.format.key() &&
+               candidate.indexType == mesh.indexType;
+    });
+
+    if (bucket == buckets.end())
+        buckets.push_back({&shader, mesh.format.key(), mesh.indexType, {{&mesh, transform}}});
+    else
+        bucket->items.push_back({&mesh, transform});
+}
+
+void DrawList::clear() {
+    // keep the buckets' allocations, scenes look much the same from one frame to the next
+    for (Bucket& bucket : buckets)
+        bucket.items.clear();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void DrawList::submit() {
+    commands.clear();
+    transforms.clear();
+    quantizations.clear();
+
+    // one command per distinct mesh in a bucket; its instances are the bucket's copies of that mesh, laid out
+    // contiguously in the transform buffer from baseInstance on
+    for (Bucket& bucket : buckets) {
+        std::ranges::stable_sort(bucket.items, {}, &Item::mesh);
+
+        bucket.firstCommand = commands.size();
+        for (std::size_t first = 0; first < bucket.items.size();) {
+            const Mesh& mesh = *bucket.items[first].mesh;
+
+            std::size_t last = first;
+            while (last < bucket.items.size() && bucket.items[last].mesh == &mesh)
+                transforms.push_back(bucket.items[last++].transform);
+
+            commands.push_back({
+                static_cast<GLuint>(mesh.indexCount),
+                static_cast<GLuint>(last - first),
+                static_cast<GLuint>(mesh.indexOffset / indexSize(mesh.indexType)),
+                mesh.baseVertex,
+                static_cast<GLuint>(transforms.size() - (last - first)),
+            });
+            quantizations.push_back({
+                glm::vec4(mesh.quantization.positionScale, 0.0f),
+                glm::vec4(mesh.quantization.positionOffset, 0.0f),
+            });
+            first = last;
+        }
+        bucket.commandCount = commands.size() - bucket.firstCommand;
+    }
+
+    if (commands.empty())
+        return;
+
+    // storage block ranges have the strictest alignment of the three; the rest only need their element size
+    static const GLsizeiptr storageAlignment = getAlignment(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT);
+
+    const std::span<const DrawElementsIndirectCommand> commandData(commands);
+    const std::span<const InstanceTransform> transformData(transforms);
+    const std::span<const DrawQuantization> quantizationData(quantizations);
+
+    stream.beginFrame();
+    stream.reserve(static_cast<GLsizeiptr>(commandData.size_bytes() + transformData.size_bytes() +
+                                           quantizationData.size_bytes()) + 3 * storageAlignment);
+    const StreamAllocation commandRange = stream.write(commandData);
+    const StreamAllocation transformRange = stream.write(transformData);
+    const StreamAllocation drawDataRange = stream.write(quantizationData, storageAlignment);
+
+    const Buffer& buffer = stream.getBuffer();
+    buffer.bind(GL_DRAW_INDIRECT_BUFFER);
+    GLState::bindBufferRange(GL_SHADER_STORAGE_BUFFER, DRAW_DATA_BINDING, buffer.id(), drawDataRange.offset, drawDataRange.size);
+
+    for (const Bucket& bucket : buckets) {
+        if (bucket.commandCount == 0)
+            continue;
+
+        bucket.shader->use();
+        bucket.shader->setInt("firstDraw", static_cast<int>(bucket.firstCommand));
+        // every mesh of the bucket shares the format, so any of this frame's will do for the vertex layout
+        meshes.bindInstanced(*bucket.items.front().mesh, *bucket.shader, buffer, transformRange.offset);
+
+        const std::size_t commandOffset = commandRange.offset + bucket.firstCommand * sizeof(DrawElementsIndirectCommand);
+        glMultiDrawElementsIndirect(GL_TRIANGLES, bucket.indexType, reinterpret_cast<const void*>(commandOffset),
+                                    static_cast<GLsizei>(bucket.commandCount), 0);
+        GLState::recordDraw();
+    }
+}
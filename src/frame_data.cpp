@@ -0,0 +1,47 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "frame_data.h"
+
+#include <span>
+
+#include <glad/glad.h>
+
+#include "gl_state.h"
+
+namespace {
+    GLsizeiptr uniformBufferAlignment() {
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        return alignment;
+    }
+}
+
+FrameUniforms::FrameUniforms() : stream(sizeof(FrameData)), alignment(uniformBufferAlignment()) {}
+
+/** Derive the per-frame matrices from the camera and upload them */
+void FrameUniforms::update(const Camera& camera, const float aspectRatio, const float time) {
+    FrameData frame{};
+    frame.view = camera.GetViewMatrix();
+    frame.projection = camera.GetProjectionMatrix(aspectRatio);
+    frame.viewProj = frame.projection * frame.view;
+    frame.cameraPosition = glm::vec4(camera.Position, 1.0f);
+    frame.time = time;
+
+    update(frame);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void FrameUniforms::update(const FrameData& frame) {
+    data = frame;
+
+    // a fresh copy per frame, so the GPU may still be reading the previous ones without anyone waiting
+    stream.beginFrame();
+    const StreamAllocation allocation = stream.write(std::span<const FrameData>(&data, 1), alignment);
+    if (allocation.data) {
+        GLState::bindBufferRange(GL_UNIFORM_BUFFER, FRAME_DATA_BINDING, stream.getBuffer().id(), allocation.offset,
+                                 allocation.size);
+    }
+}
@@ -0,0 +1,177 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "gl_objects.h"
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+
+#include <stb_image.h>
+
+namespace gl_detail {
+    void deleteBuffer(const GLuint name) {
+        GLState::forgetBuffer(name);
+        glDeleteBuffers(1, &name);
+    }
+
+    void deleteVertexArray(const GLuint name) {
+        GLState::forgetVertexArray(name);
+        glDeleteVertexArrays(1, &name);
+    }
+
+    void deleteTexture(const GLuint name) {
+        GLState::forgetTexture(name);
+        glDeleteTextures(1, &name);
+    }
+
+    void deleteFramebuffer(const GLuint name) {
+        GLState::forgetFramebuffer(name);
+        glDeleteFramebuffers(1, &name);
+    }
+
+    void deleteRenderbuffer(const GLuint name) {
+        glDeleteRenderbuffers(1, &name);
+    }
+}
+
+// Buffer
+// ---------------------------------------------------------------------------------------------------------------------
+Buffer::Buffer(const GLsizeiptr size, const void* data, const GLbitfield flags) : byteSize(size) {
+    GLuint name;
+    glCreateBuffers(1, &name);
+    glNamedBufferStorage(name, size, data, flags);
+    handle = GLHandle<gl_detail::deleteBuffer>(name);
+}
+
+void Buffer::upload(const GLintptr offset, const GLsizeiptr length, const void* data) const {
+    glNamedBufferSubData(handle.get(), offset, length, data);
+}
+
+void Buffer::copy(const Buffer& source, const GLintptr sourceOffset, const GLintptr offset, const GLsizeiptr length) const {
+    glCopyNamedBufferSubData(source.id(), handle.get(), sourceOffset, offset, length);
+}
+
+void* Buffer::map(const GLbitfield access) const {
+    return glMapNamedBufferRange(handle.get(), 0, byteSize, access);
+}
+
+// VertexArray
+// ---------------------------------------------------------------------------------------------------------------------
+VertexArray::VertexArray() {
+    GLuint name;
+    glCreateVertexArrays(1, &name);
+    handle = GLHandle<gl_detail::deleteVertexArray>(name);
+}
+
+void VertexArray::vertexBuffer(const GLuint binding, const Buffer& buffer, const GLintptr offset, const GLsizei stride) const {
+    glVertexArrayVertexBuffer(handle.get(), binding, buffer.id(), offset, stride);
+}
+
+void VertexArray::elementBuffer(const Buffer& buffer) const {
+    glVertexArrayElementBuffer(handle.get(), buffer.id());
+}
+
+void VertexArray::bindingDivisor(const GLuint binding, const GLuint divisor) const {
+    glVertexArrayBindingDivisor(handle.get(), binding, divisor);
+}
+
+void VertexArray::attribute(const GLuint location, const GLuint binding, const GLint size, const GLenum type,
+                            const GLuint relativeOffset, const bool normalized) const {
+    glEnableVertexArrayAttrib(handle.get(), location);
+    glVertexArrayAttribFormat(handle.get(), location, size, type, normalized ? GL_TRUE : GL_FALSE, relativeOffset);
+    glVertexArrayAttribBinding(handle.get(), location, binding);
+}
+
+// Texture
+// ---------------------------------------------------------------------------------------------------------------------
+Texture::Texture(const GLsizei width, const GLsizei height, const GLenum internalFormat, const GLsizei levels) :
+width(width), height(height) {
+    GLuint name;
+    glCreateTextures(GL_TEXTURE_2D, 1, &name);
+    glTextureStorage2D(name, levels, internalFormat, width, height);
+    handle = GLHandle<gl_detail::deleteTexture>(name);
+}
+
+Texture Texture::load(const char* path) {
+    int width, height, nrComponents;
+    unsigned char* data = stbi_load(path, &width, &height, &nrComponents, 0);
+    if (!data) {
+        std::cout << "Texture failed to load at path: " << path << std::endl;
+        return {};
+    }
+
+    GLenum format = GL_RGBA;
+    GLenum internalFormat = GL_RGBA8;
+    if (nrComponents == 1) {
+        format = GL_RED;
+        internalFormat = GL_R8;
+    }
+    else if (nrComponents == 3) {
+        format = GL_RGB;
+        internalFormat = GL_RGB8;
+    }
+
+    // immutable storage wants the level count up front: a full chain down to 1x1
+    const auto largest = static_cast<unsigned int>(std::max(width, height));
+    const auto levels = static_cast<GLsizei>(std::bit_width(largest));
+
+    Texture texture(width, height, internalFormat, levels);
+
+    // rows of RGB and R8 images are not necessarily 4-byte aligned
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    texture.upload(0, width, height, format, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    texture.generateMipmaps();
+
+    texture.setParameter(GL_TEXTURE_WRAP_S, GL_REPEAT);
+    texture.setParameter(GL_TEXTURE_WRAP_T, GL_REPEAT);
+    texture.setParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    texture.setParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    stbi_image_free(data);
+    return texture;
+}
+
+void Texture::upload(const GLint level, const GLsizei width, const GLsizei height, const GLenum format, const GLenum type,
+                     const void* pixels) const {
+    glTextureSubImage2D(handle.get(), level, 0, 0, width, height, format, type, pixels);
+}
+
+void Texture::generateMipmaps() const {
+    glGenerateTextureMipmap(handle.get());
+}
+
+void Texture::setParameter(const GLenum name, const GLint value) const {
+    glTextureParameteri(handle.get(), name, value);
+}
+
+// Renderbuffer
+// ---------------------------------------------------------------------------------------------------------------------
+Renderbuffer::Renderbuffer(const GLenum internalFormat, const GLsizei width, const GLsizei height) {
+    GLuint name;
+    glCreateRenderbuffers(1, &name);
+    glNamedRenderbufferStorage(name, internalFormat, width, height);
+    handle = GLHandle<gl_detail::deleteRenderbuffer>(name);
+}
+
+// Framebuffer
+// ---------------------------------------------------------------------------------------------------------------------
+Framebuffer::Framebuffer() {
+    GLuint name;
+    glCreateFramebuffers(1, &name);
+    handle = GLHandle<gl_detail::deleteFramebuffer>(name);
+}
+
+void Framebuffer::attach(const GLenum attachment, const Texture& texture, const GLint level) const {
+    glNamedFramebufferTexture(handle.get(), attachment, texture.id(), level);
+}
+
+void Framebuffer::attach(const GLenum attachment, const Renderbuffer& renderbuffer) const {
+    glNamedFramebufferRenderbuffer(handle.get(), attachment, GL_RENDERBUFFER, renderbuffer.id());
+}
+
+bool Framebuffer::complete() const {
+    return glCheckNamedFramebufferStatus(handle.get(), GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
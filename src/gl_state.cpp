@@ -0,0 +1,207 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "gl_state.h"
+
+#include <algorithm>
+
+namespace {
+    template<typename Array, typename T>
+    std::size_t indexOf(const Array& array, const T value) {
+        return static_cast<std::size_t>(std::find(array.begin(), array.end(), value) - array.begin());
+    }
+
+    template<typename Array>
+    void forgetIn(Array& array, const GLuint name) {
+        std::replace(array.begin(), array.end(), name, GLState::UNKNOWN);
+    }
+}
+
+void GLState::useProgram(const GLuint program) {
+    if (changes(mirror.program, program))
+        glUseProgram(program);
+}
+
+void GLState::bindProgramPipeline(const GLuint pipeline) {
+    if (changes(mirror.pipeline, pipeline))
+        glBindProgramPipeline(pipeline);
+}
+
+void GLState::bindVertexArray(const GLuint vertexArray) {
+    if (!changes(mirror.vertexArray, vertexArray))
+        return;
+
+    glBindVertexArray(vertexArray);
+
+    // the element buffer binding is part of the vertex array
+    mirror.buffers[indexOf(BUFFER_TARGETS, GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+}
+
+void GLState::bindTexture(const GLuint unit, const GLuint texture) {
+    if (unit >= MAX_TEXTURE_UNITS) {
+        stats.forwarded++;
+        glBindTextureUnit(unit, texture);
+        return;
+    }
+
+    if (changes(mirror.textures[unit], texture))
+        glBindTextureUnit(unit, texture);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void GLState::bindBuffer(const GLenum target, const GLuint buffer) {
+    const std::size_t index = indexOf(BUFFER_TARGETS, target);
+    if (index == BUFFER_TARGETS.size()) {
+        stats.forwarded++;
+        glBindBuffer(target, buffer);
+        return;
+    }
+
+    if (changes(mirror.buffers[index], buffer))
+        glBindBuffer(target, buffer);
+}
+
+void GLState::bindBufferBase(const GLenum target, const GLuint index, const GLuint buffer) {
+    std::array<GLuint, MAX_BUFFER_BINDINGS>* bindings = nullptr;
+    if (target == GL_UNIFORM_BUFFER)
+        bindings = &mirror.uniformBuffers;
+    else if (target == GL_SHADER_STORAGE_BUFFER)
+        bindings = &mirror.storageBuffers;
+
+    if (!bindings || index >= MAX_BUFFER_BINDINGS) {
+        stats.forwarded++;
+        glBindBufferBase(target, index, buffer);
+    }
+    else if (changes((*bindings)[index], buffer)) {
+        glBindBufferBase(target, index, buffer);
+    }
+    else {
+        return;
+    }
+
+    // glBindBufferBase binds the generic target as well
+    const std::size_t generic = indexOf(BUFFER_TARGETS, target);
+    if (generic != BUFFER_TARGETS.size())
+        mirror.buffers[generic] = buffer;
+}
+
+void GLState::bindBufferRange(const GLenum target, const GLuint index, const GLuint buffer, const GLintptr offset,
+                              const GLsizeiptr size) {
+    // ranges move every frame when streaming, so they are not mirrored; the base binding is no longer known though
+    stats.forwarded++;
+    glBindBufferRange(target, index, buffer, offset, size);
+
+    if (index < MAX_BUFFER_BINDINGS) {
+        if (target == GL_UNIFORM_BUFFER)
+            mirror.uniformBuffers[index] = UNKNOWN;
+        else if (target == GL_SHADER_STORAGE_BUFFER)
+            mirror.storageBuffers[index] = UNKNOWN;
+    }
+
+    const std::size_t generic = indexOf(BUFFER_TARGETS, target);
+    if (generic != BUFFER_TARGETS.size())
+        mirror.buffers[generic] = buffer;
+}
+
+void GLState::bindFramebuffer(const GLenum target, const GLuint framebuffer) {
+    if (target == GL_FRAMEBUFFER) {
+        // counts as one call; forward it when either half differs
+        if (mirror.drawFramebuffer == framebuffer && mirror.readFramebuffer == framebuffer) {
+            stats.avoided++;
+            return;
+        }
+        mirror.drawFramebuffer = framebuffer;
+        mirror.readFramebuffer = framebuffer;
+        stats.forwarded++;
+        glBindFramebuffer(target, framebuffer);
+        return;
+    }
+
+    GLuint& slot = target == GL_DRAW_FRAMEBUFFER ? mirror.drawFramebuffer : mirror.readFramebuffer;
+    if (changes(slot, framebuffer))
+        glBindFramebuffer(target, framebuffer);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void GLState::enable(const GLenum capability) {
+    setCapability(capability, true);
+}
+
+void GLState::disable(const GLenum capability) {
+    setCapability(capability, false);
+}
+
+void GLState::setCapability(const GLenum capability, const bool enabled) {
+    const std::size_t index = indexOf(CAPABILITIES, capability);
+    if (index != CAPABILITIES.size() && !changes(mirror.capabilities[index], static_cast<std::int8_t>(enabled)))
+        return;
+    if (index == CAPABILITIES.size())
+        stats.forwarded++;
+
+    if (enabled)
+        glEnable(capability);
+    else
+        glDisable(capability);
+}
+
+void GLState::depthFunc(const GLenum func) {
+    if (changes(mirror.depthFunc, func))
+        glDepthFunc(func);
+}
+
+void GLState::depthMask(const bool write) {
+    if (changes(mirror.depthMask, static_cast<std::int8_t>(write)))
+        glDepthMask(write ? GL_TRUE : GL_FALSE);
+}
+
+void GLState::blendFunc(const GLenum source, const GLenum destination) {
+    if (mirror.blendSource == source && mirror.blendDestination == destination) {
+        stats.avoided++;
+        return;
+    }
+    mirror.blendSource = source;
+    mirror.blendDestination = destination;
+    stats.forwarded++;
+    glBlendFunc(source, destination);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void GLState::invalidate() {
+    mirror = Mirror{};
+}
+
+void GLState::forgetProgram(const GLuint program) {
+    if (mirror.program == program)
+        mirror.program = UNKNOWN;
+}
+
+void GLState::forgetPipeline(const GLuint pipeline) {
+    if (mirror.pipeline == pipeline)
+        mirror.pipeline = UNKNOWN;
+}
+
+void GLState::forgetVertexArray(const GLuint vertexArray) {
+    if (mirror.vertexArray == vertexArray)
+        mirror.vertexArray = UNKNOWN;
+}
+
+void GLState::forgetTexture(const GLuint texture) {
+    forgetIn(mirror.textures, texture);
+}
+
+void GLState::forgetBuffer(const GLuint buffer) {
+    forgetIn(mirror.buffers, buffer);
+    forgetIn(mirror.uniformBuffers, buffer);
+    forgetIn(mirror.storageBuffers, buffer);
+}
+
+void GLState::forgetFramebuffer(const GLuint framebuffer) {
+    if (mirror.drawFramebuffer == framebuffer)
+        mirror.drawFramebuffer = UNKNOWN;
+    if (mirror.readFramebuffer == framebuffer)
+        mirror.readFramebuffer = UNKNOWN;
+}
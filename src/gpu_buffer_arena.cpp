@@ -0,0 +1,124 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "gpu_buffer_arena.h"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <utility>
+
+namespace {
+    GLsizeiptr roundUp(const GLsizeiptr value, const GLsizeiptr multiple) {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+}
+
+GpuBufferArena::GpuBufferArena(const GLsizeiptr capacity)
+    : allocator(static_cast<std::uint32_t>(roundUp(capacity, GRANULARITY) / GRANULARITY)),
+      buffer(roundUp(capacity, GRANULARITY), nullptr, GL_DYNAMIC_STORAGE_BIT) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool GpuBufferArena::place(Range& range) {
+    // blocks start on multiples of GRANULARITY, so reaching the next multiple of alignment takes at most this much
+    const GLsizeiptr padding = range.alignment - std::gcd(range.alignment, GRANULARITY);
+    const auto units = static_cast<std::uint32_t>(roundUp(range.size + padding, GRANULARITY) / GRANULARITY);
+
+    range.block = allocator.allocate(units);
+    if (!range.block.valid())
+        return false;
+
+    range.offset = roundUp(static_cast<GLintptr>(range.block.offset) * GRANULARITY, range.alignment);
+    return true;
+}
+
+GpuBufferArena::Handle GpuBufferArena::allocate(const GLsizeiptr size, const GLsizeiptr alignment) {
+    if (size <= 0 || alignment <= 0) {
+        std::cerr << "ERROR::GPU_BUFFER_ARENA::INVALID_SIZE " << size << " bytes aligned to " << alignment << std::endl;
+        return INVALID_HANDLE;
+    }
+
+    Range range{{}, 0, size, alignment, true};
+    if (!place(range)) {
+        grow(size + alignment);
+        if (!place(range)) {
+            std::cerr << "ERROR::GPU_BUFFER_ARENA::OUT_OF_SPACE " << size << " bytes requested" << std::endl;
+            return INVALID_HANDLE;
+        }
+    }
+    usedBytes += size;
+
+    if (freeHandles.empty()) {
+        ranges.push_back(range);
+        return static_cast<Handle>(ranges.size() - 1);
+    }
+    const Handle handle = freeHandles.back();
+    freeHandles.pop_back();
+    ranges[handle] = range;
+    return handle;
+}
+
+void GpuBufferArena::free(const Handle handle) {
+    if (handle == INVALID_HANDLE || handle >= ranges.size() || !ranges[handle].live) {
+        std::cerr << "ERROR::GPU_BUFFER_ARENA::INVALID_HANDLE " << handle << std::endl;
+        return;
+    }
+
+    allocator.free(ranges[handle].block);
+    usedBytes -= ranges[handle].size;
+    ranges[handle] = Range{};
+    freeHandles.push_back(handle);
+}
+
+void GpuBufferArena::upload(const Handle handle, const void* data, const GLsizeiptr size) const {
+    const Range& range = ranges[handle];
+    buffer.upload(range.offset, std::min(size, range.size), data);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void GpuBufferArena::grow(const GLsizeiptr needed) {
+    GLsizeiptr capacity = std::max(buffer.size(), GRANULARITY);
+    while (capacity < buffer.size() + needed)
+        capacity *= 2;
+
+    // offsets stay put, so one copy of the whole old buffer carries every range over
+    Buffer grown(capacity, nullptr, GL_DYNAMIC_STORAGE_BIT);
+    grown.copy(buffer, 0, 0, buffer.size());
+    buffer = std::move(grown);
+
+    allocator.grow(static_cast<std::uint32_t>(capacity / GRANULARITY));
+    generation++;
+}
+
+void GpuBufferArena::compact() {
+    std::vector<Handle> live;
+    for (Handle handle = 0; handle < ranges.size(); handle++) {
+        if (ranges[handle].live)
+            live.push_back(handle);
+    }
+    std::ranges::sort(live, {}, [&](const Handle handle) { return ranges[handle].offset; });
+
+    // a fresh allocator hands out blocks front to back, so placing the ranges in address order packs them tightly
+    allocator = OffsetAllocator(static_cast<std::uint32_t>(buffer.size() / GRANULARITY));
+    Buffer packed(buffer.size(), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+    for (const Handle handle : live) {
+        Range& range = ranges[handle];
+        const GLintptr oldOffset = range.offset;
+        place(range);
+        packed.copy(buffer, oldOffset, range.offset, range.size);
+    }
+
+    buffer = std::move(packed);
+    generation++;
+}
+
+float GpuBufferArena::getFragmentation() const {
+    const std::uint32_t freeUnits = allocator.getFreeSize();
+    if (freeUnits == 0)
+        return 0.0f;
+    return 1.0f - static_cast<float>(allocator.getLargestFree()) / static_cast<float>(freeUnits);
+}
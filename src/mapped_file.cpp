@@ -0,0 +1,77 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "mapped_file.h"
+
+#include <fstream>
+#include <utility>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef __linux__
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return;
+
+    struct stat status{};
+    if (fstat(fd, &status) == 0 && status.st_size > 0) {
+        void* mapping = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            // parsers read front to back; let the kernel read ahead aggressively
+            madvise(mapping, static_cast<std::size_t>(status.st_size), MADV_SEQUENTIAL);
+            data = static_cast<const std::byte*>(mapping);
+            size = static_cast<std::size_t>(status.st_size);
+            mapped = true;
+        }
+    }
+    // the mapping keeps its own reference to the file
+    close(fd);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return;
+
+    fallback.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(fallback.data()), static_cast<std::streamsize>(fallback.size()));
+    data = fallback.data();
+    size = fallback.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)),
+      mapped(std::exchange(other.mapped, false)), fallback(std::move(other.fallback)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+        mapped = std::exchange(other.mapped, false);
+        fallback = std::move(other.fallback);
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+#ifdef __linux__
+    if (mapped)
+        munmap(const_cast<std::byte*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+    mapped = false;
+    fallback.clear();
+}
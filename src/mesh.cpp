@@ -0,0 +1,105 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace {
+    /** Append the quad spanned by tangent and bitangent around centre; tangent x bitangent must be the normal */
+    void appendQuad(MeshData& mesh, const glm::vec3 centre, const glm::vec3 tangent, const glm::vec3 bitangent,
+                    const glm::vec3 normal) {
+        const auto first = static_cast<std::uint32_t>(mesh.vertices.size());
+        constexpr glm::vec2 corners[] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+        for (const glm::vec2 uv : corners)
+            mesh.vertices.push_back({centre + (uv.x - 0.5f) * tangent + (uv.y - 0.5f) * bitangent, normal, uv});
+
+        mesh.indices.insert(mesh.indices.end(), {first, first + 1, first + 2, first + 2, first + 3, first});
+    }
+}
+
+MeshData primitives::cube() {
+    MeshData mesh;
+    mesh.vertices.reserve(24);
+    mesh.indices.reserve(36);
+
+    // per face: normal and the tangent the texture's u axis follows; v runs along cross(normal, tangent)
+    constexpr glm::vec3 faces[][2] = {
+        {{ 0.0f,  0.0f, -1.0f}, {-1.0f,  0.0f,  0.0f}},
+        {{ 0.0f,  0.0f,  1.0f}, { 1.0f,  0.0f,  0.0f}},
+        {{-1.0f,  0.0f,  0.0f}, { 0.0f,  0.0f,  1.0f}},
+        {{ 1.0f,  0.0f,  0.0f}, { 0.0f,  0.0f, -1.0f}},
+        {{ 0.0f, -1.0f,  0.0f}, { 1.0f,  0.0f,  0.0f}},
+        {{ 0.0f,  1.0f,  0.0f}, { 1.0f,  0.0f,  0.0f}},
+    };
+    for (const auto& [normal, tangent] : faces)
+        appendQuad(mesh, 0.5f * normal, tangent, glm::cross(normal, tangent), normal);
+
+    return mesh;
+}
+
+MeshData primitives::plane(int subdivisions) {
+    subdivisions = std::max(subdivisions, 1);
+    const int columns = subdivisions + 1;
+
+    MeshData mesh;
+    mesh.vertices.reserve(columns * columns);
+    mesh.indices.reserve(subdivisions * subdivisions * 6);
+
+    for (int row = 0; row < columns; row++) {
+        for (int column = 0; column < columns; column++) {
+            const glm::vec2 uv(static_cast<float>(column) / subdivisions, static_cast<float>(row) / subdivisions);
+            // v runs towards -Z so that u x v points up and the triangles face +Y
+            mesh.vertices.push_back({{uv.x - 0.5f, 0.0f, 0.5f - uv.y}, {0.0f, 1.0f, 0.0f}, uv});
+        }
+    }
+
+    for (int row = 0; row < subdivisions; row++) {
+        for (int column = 0; column < subdivisions; column++) {
+            const auto corner = static_cast<std::uint32_t>(row * columns + column);
+            const auto above = corner + static_cast<std::uint32_t>(columns);
+            mesh.indices.insert(mesh.indices.end(), {corner, corner + 1, above + 1, above + 1, above, corner});
+        }
+    }
+
+    return mesh;
+}
+
+MeshData primitives::sphere(int segments, int rings) {
+    segments = std::max(segments, 3);
+    rings = std::max(rings, 2);
+    const int columns = segments + 1;
+
+    MeshData mesh;
+    mesh.vertices.reserve(columns * (rings + 1));
+    mesh.indices.reserve(segments * (rings - 1) * 6);
+
+    for (int ring = 0; ring <= rings; ring++) {
+        const float v = static_cast<float>(ring) / rings;
+        const float polar = v * std::numbers::pi_v<float>;
+        for (int segment = 0; segment <= segments; segment++) {
+            const float u = static_cast<float>(segment) / segments;
+            const float azimuth = u * 2.0f * std::numbers::pi_v<float>;
+            // ring 0 is the north pole; u increases counter-clockwise seen from above
+            const glm::vec3 normal(std::sin(polar) * std::sin(azimuth), std::cos(polar), std::sin(polar) * std::cos(azimuth));
+            mesh.vertices.push_back({0.5f * normal, normal, {u, 1.0f - v}});
+        }
+    }
+
+    for (int ring = 0; ring < rings; ring++) {
+        for (int segment = 0; segment < segments; segment++) {
+            const auto top = static_cast<std::uint32_t>(ring * columns + segment);
+            const auto bottom = top + static_cast<std::uint32_t>(columns);
+            // the pole rows collapse to a point, so each of their quads is a single triangle
+            if (ring != 0)
+                mesh.indices.insert(mesh.indices.end(), {top, bottom, top + 1});
+            if (ring != rings - 1)
+                mesh.indices.insert(mesh.indices.end(), {top + 1, bottom, bottom + 1});
+        }
+    }
+
+    return mesh;
+}
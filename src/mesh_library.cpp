@@ -0,0 +1,242 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "mesh_library.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "gl_state.h"
+#include "object_buffer.h"
+#include "shader.h"
+#include "string_hash.h"
+
+namespace {
+    // enough for the primitives and a few models before the first grow
+    constexpr GLsizeiptr INITIAL_VERTEX_BYTES = 4 * 1024 * 1024;
+    constexpr GLsizeiptr INITIAL_INDEX_BYTES = 1024 * 1024;
+}
+
+MeshLibrary::MeshLibrary() : vertexArena(INITIAL_VERTEX_BYTES), indexArena(INITIAL_INDEX_BYTES) {
+    add("cube", primitives::cube());
+    add("plane", primitives::plane());
+    add("sphere", primitives::sphere());
+}
+
+const Mesh& MeshLibrary::add(const std::string_view name, const MeshView data, const VertexFormat format) {
+    const auto [it, inserted] = meshes.try_emplace(hashString(name));
+    if (!inserted) {
+        std::cerr << "ERROR::MESH_LIBRARY::DUPLICATE_NAME " << name << std::endl;
+        return it->second.mesh;
+    }
+
+    Entry& entry = it->second;
+    Mesh& mesh = entry.mesh;
+    mesh.format = format;
+    mesh.vertexCount = static_cast<GLsizei>(data.vertices.size());
+    mesh.indexCount = static_cast<GLsizei>(data.indices.size());
+
+    // float vertices are already in the GPU layout and 32-bit indices need no narrowing: those go up straight from
+    // data, so a mesh in a mapped file reaches the buffer without a copy
+    std::vector<std::byte> encodedVertices;
+    std::span<const std::byte> vertices = std::as_bytes(data.vertices);
+    if (format.key() != VertexFormat{}.key()) {
+        mesh.quantization = encodeVertices(data.vertices, format, encodedVertices, data.tangents);
+        vertices = encodedVertices;
+    }
+
+    // indices are relative to baseVertex, so only the mesh's own vertex count decides the width
+    const bool shortIndices = data.vertices.size() <= std::numeric_limits<std::uint16_t>::max() + std::size_t{1};
+    mesh.indexType = shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+    std::vector<std::uint16_t> shortIndexData;
+    std::span<const std::byte> indices = std::as_bytes(data.indices);
+    if (shortIndices) {
+        shortIndexData.assign(data.indices.begin(), data.indices.end());
+        indices = std::as_bytes(std::span<const std::uint16_t>(shortIndexData));
+    }
+
+    // baseVertex counts in strides of this mesh's format, so its range has to start on a multiple of that stride
+    const auto stride = static_cast<GLsizeiptr>(format.stride());
+    entry.vertices = vertexArena.allocate(static_cast<GLsizeiptr>(vertices.size()), stride);
+    entry.indices = indexArena.allocate(static_cast<GLsizeiptr>(indices.size()), 4);
+    vertexArena.upload(entry.vertices, vertices.data(), static_cast<GLsizeiptr>(vertices.size()));
+    indexArena.upload(entry.indices, indices.data(), static_cast<GLsizeiptr>(indices.size()));
+    mesh.baseVertex = static_cast<GLint>(vertexArena.getOffset(entry.vertices) / stride);
+    mesh.indexOffset = static_cast<std::uintptr_t>(indexArena.getOffset(entry.indices));
+
+    memory.vertexBytes += vertices.size();
+    memory.floatVertexBytes += data.vertices.size() * sizeof(Vertex);
+    memory.indexBytes += indices.size();
+
+    if (const auto [layout, created] = layouts.try_emplace(format.key()); created) {
+        layout->second.format = format;
+        format.applyLayout(layout->second.vertexArray);
+        format.applyLayout(layout->second.instancedVertexArray);
+        InstanceTransform::applyLayout(layout->second.instancedVertexArray, 1);
+
+        for (const VertexArray* vertexArray : {&layout->second.vertexArray, &layout->second.instancedVertexArray}) {
+            vertexArray->vertexBuffer(0, vertexArena.getBuffer(), 0, static_cast<GLsizei>(stride));
+            vertexArray->elementBuffer(indexArena.getBuffer());
+        }
+    }
+
+    // either allocation may have grown its arena into a new buffer
+    relocate();
+    return mesh;
+}
+
+void MeshLibrary::remove(const std::string_view name) {
+    const auto found = meshes.find(hashString(name));
+    if (found == meshes.end()) {
+        std::cerr << "ERROR::MESH_LIBRARY::UNKNOWN_NAME " << name << std::endl;
+        return;
+    }
+
+    const Entry& entry = found->second;
+    memory.vertexBytes -= static_cast<std::size_t>(entry.mesh.vertexCount) * entry.mesh.format.stride();
+    memory.floatVertexBytes -= static_cast<std::size_t>(entry.mesh.vertexCount) * sizeof(Vertex);
+    memory.indexBytes -= static_cast<std::size_t>(entry.mesh.indexCount) *
+                         (entry.mesh.indexType == GL_UNSIGNED_SHORT ? sizeof(std::uint16_t) : sizeof(std::uint32_t));
+
+    vertexArena.free(entry.vertices);
+    indexArena.free(entry.indices);
+    meshes.erase(found);
+}
+
+void MeshLibrary::compact() {
+    vertexArena.compact();
+    indexArena.compact();
+    relocate();
+}
+
+const Mesh* MeshLibrary::get(const std::string_view name) const {
+    const auto found = meshes.find(hashString(name));
+    if (found == meshes.end()) {
+        std::cerr << "ERROR::MESH_LIBRARY::UNKNOWN_NAME " << name << std::endl;
+        return nullptr;
+    }
+    return &found->second.mesh;
+}
+
+void MeshLibrary::relocate() {
+    if (vertexArena.getGeneration() == vertexGeneration && indexArena.getGeneration() == indexGeneration)
+        return;
+    vertexGeneration = vertexArena.getGeneration();
+    indexGeneration = indexArena.getGeneration();
+
+    for (auto& [hash, entry] : meshes) {
+        entry.mesh.baseVertex = static_cast<GLint>(vertexArena.getOffset(entry.vertices) /
+                                                   static_cast<GLintptr>(entry.mesh.format.stride()));
+        entry.mesh.indexOffset = static_cast<std::uintptr_t>(indexArena.getOffset(entry.indices));
+    }
+
+    for (const auto& [key, layout] : layouts) {
+        for (const VertexArray* vertexArray : {&layout.vertexArray, &layout.instancedVertexArray}) {
+            vertexArray->vertexBuffer(0, vertexArena.getBuffer(), 0, static_cast<GLsizei>(layout.format.stride()));
+            vertexArray->elementBuffer(indexArena.getBuffer());
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void MeshLibrary::bind(const Mesh& mesh) {
+    layouts.at(mesh.format.key()).vertexArray.bind();
+}
+
+void MeshLibrary::draw(const Mesh& mesh, const Shader& shader) {
+    bind(mesh);
+    prepare(mesh, shader);
+
+    glDrawElementsBaseVertex(GL_TRIANGLES, mesh.indexCount, mesh.indexType,
+                             reinterpret_cast<const void*>(mesh.indexOffset), mesh.baseVertex);
+    GLState::recordDraw();
+
+    drawStats.draws++;
+    drawStats.instances++;
+    drawStats.fetchedBytes += static_cast<std::size_t>(mesh.vertexCount) * mesh.format.stride();
+    drawStats.floatFetchedBytes += static_cast<std::size_t>(mesh.vertexCount) * sizeof(Vertex);
+}
+
+void MeshLibrary::drawInstanced(const Mesh& mesh, const Shader& shader, const Buffer& instances, const GLsizei count,
+                                const GLuint first) {
+    bindInstanced(mesh, shader, instances);
+
+    glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, mesh.indexCount, mesh.indexType,
+                                                  reinterpret_cast<const void*>(mesh.indexOffset), count,
+                                                  mesh.baseVertex, first);
+    GLState::recordDraw();
+
+    const std::size_t instanceBytes = static_cast<std::size_t>(count) * sizeof(InstanceTransform);
+    drawStats.draws++;
+    drawStats.instances += static_cast<unsigned int>(count);
+    drawStats.fetchedBytes += static_cast<std::size_t>(count) * mesh.vertexCount * mesh.format.stride() + instanceBytes;
+    drawStats.floatFetchedBytes += static_cast<std::size_t>(count) * mesh.vertexCount * sizeof(Vertex) + instanceBytes;
+}
+
+void MeshLibrary::drawObjects(const Mesh& mesh, const Shader& shader, const GLuint first, const GLsizei count) {
+    bind(mesh);
+    prepare(mesh, shader);
+
+    // the shader finds its ObjectData at gl_BaseInstance + gl_InstanceID; no attribute is instanced, so the plain
+    // vertex array does
+    glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, mesh.indexCount, mesh.indexType,
+                                                  reinterpret_cast<const void*>(mesh.indexOffset), count,
+                                                  mesh.baseVertex, first);
+    GLState::recordDraw();
+
+    const std::size_t objectBytes = static_cast<std::size_t>(count) * sizeof(ObjectData);
+    drawStats.draws++;
+    drawStats.instances += static_cast<unsigned int>(count);
+    drawStats.fetchedBytes += static_cast<std::size_t>(count) * mesh.vertexCount * mesh.format.stride() + objectBytes;
+    drawStats.floatFetchedBytes += static_cast<std::size_t>(count) * mesh.vertexCount * sizeof(Vertex) + objectBytes;
+}
+
+void MeshLibrary::drawIndirect(const Mesh& mesh, const Shader& shader, const Buffer& commands, const GLintptr offset,
+                               const GLsizei count) {
+    if (count == 0)
+        return;
+
+    bind(mesh);
+    prepare(mesh, shader);
+    commands.bind(GL_DRAW_INDIRECT_BUFFER);
+
+    glMultiDrawElementsIndirect(GL_TRIANGLES, mesh.indexType, reinterpret_cast<const void*>(offset), count, 0);
+    GLState::recordDraw();
+
+    drawStats.draws++;
+    drawStats.instances += static_cast<unsigned int>(count);
+}
+
+void MeshLibrary::bindInstanced(const Mesh& mesh, const Shader& shader, const Buffer& instances, const GLintptr offset) {
+    prepare(mesh, shader);
+
+    // instance buffers are owned by the caller; pointing the binding at one is a single DSA call on the vertex array
+    const VertexArray& vertexArray = layouts.at(mesh.format.key()).instancedVertexArray;
+    vertexArray.vertexBuffer(1, instances, offset, sizeof(InstanceTransform));
+    vertexArray.bind();
+}
+
+MeshMemoryStats MeshLibrary::getMemoryStats() const {
+    MeshMemoryStats stats = memory;
+    stats.arenaBytes = static_cast<std::size_t>(vertexArena.getCapacity() + indexArena.getCapacity());
+    stats.fragmentation = std::max(vertexArena.getFragmentation(), indexArena.getFragmentation());
+    return stats;
+}
+
+MeshDrawStats MeshLibrary::takeDrawStats() {
+    return std::exchange(drawStats, {});
+}
+
+void MeshLibrary::prepare(const Mesh& mesh, const Shader& shader) {
+    // unchanged values are skipped by the uniform shadow, so consecutive draws of one format cost nothing here
+    shader.setVec3("positionScale", mesh.quantization.positionScale);
+    shader.setVec3("positionOffset", mesh.quantization.positionOffset);
+    shader.setBool("octahedralNormals", mesh.format.normal == NormalFormat::Octahedral);
+}
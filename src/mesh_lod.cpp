@@ -0,0 +1,80 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "mesh_lod.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <string>
+
+#include "camera.h"
+#include "mesh_simplifier.h"
+
+LodMesh addLodMesh(MeshLibrary& library, ThreadPool& pool, const std::string_view name, const MeshData& data,
+                   const std::size_t levelCount, const VertexFormat format) {
+    LodMesh lod;
+    if (data.indices.empty())
+        return lod;
+
+    for (const Vertex& vertex : data.vertices)
+        lod.radius = std::max(lod.radius, glm::length(vertex.position));
+
+    // every level starts from the original, so they are independent and errors don't compound
+    const std::size_t triangles = data.indices.size() / 3;
+    std::vector<std::future<SimplifiedMesh>> pending;
+    for (std::size_t level = 1; level < levelCount; level++) {
+        const std::size_t target = std::max<std::size_t>(triangles >> level, 1);
+        pending.push_back(pool.submit([&data, target] { return simplifyMesh(data, target); }));
+    }
+
+    lod.levels.push_back({&library.add(name, data, format), triangles, 0.0f});
+    for (std::size_t level = 1; level < levelCount; level++) {
+        SimplifiedMesh simplified = pending[level - 1].get();
+        const std::size_t simplifiedTriangles = simplified.data.indices.size() / 3;
+        if (lod.levels.size() != level || simplifiedTriangles * 5 > lod.levels.back().triangles * 4)
+            continue; // keep draining the futures, they reference data
+
+        const std::string levelName = std::string(name) + "#lod" + std::to_string(level);
+        const float error = std::max(simplified.error, lod.levels.back().error);
+        lod.levels.push_back({&library.add(levelName, simplified.data, format), simplifiedTriangles, error});
+    }
+    return lod;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+LodSelector::LodSelector(const float pixelThreshold, const float hysteresis)
+    : pixelThreshold(pixelThreshold), hysteresis(hysteresis) {}
+
+void LodSelector::setView(const Camera& camera, const float viewportHeight) {
+    cameraPosition = camera.Position;
+    pixelsPerUnit = viewportHeight / (2.0f * std::tan(glm::radians(camera.Zoom) * 0.5f));
+}
+
+std::size_t LodSelector::select(const LodMesh& lod, const glm::vec3& centre, const float scale, std::uint8_t& current) const {
+    if (lod.levels.empty())
+        return 0;
+
+    // inside the bounding sphere every level is too coarse; the near plane is as close as anything gets
+    const float distance = std::max(glm::length(centre - cameraPosition) - lod.radius * scale, 0.1f);
+    const float pixelsPerError = scale * pixelsPerUnit / distance;
+
+    std::size_t coarsest = 0, coarsestWithMargin = 0;
+    for (std::size_t level = 1; level < lod.levels.size(); level++) {
+        const float pixels = lod.levels[level].error * pixelsPerError;
+        if (pixels <= pixelThreshold * (1.0f + hysteresis))
+            coarsest = level;
+        if (pixels <= pixelThreshold * (1.0f - hysteresis))
+            coarsestWithMargin = level;
+    }
+
+    std::size_t level = std::min<std::size_t>(current, lod.levels.size() - 1);
+    if (level > coarsest)
+        level = coarsest;
+    else if (level < coarsestWithMargin)
+        level = coarsestWithMargin;
+    current = static_cast<std::uint8_t>(level);
+    return level;
+}
@@ -0,0 +1,373 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include <glm/glm.hpp>
+
+namespace {
+    constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+    /**
+     * FIFO cache by timestamps: a vertex is cached while fewer than cacheSize misses happened since its own. Bumping
+     * time by cacheSize + 1 empties the cache without touching the array.
+     */
+    struct CacheSimulation {
+        std::vector<std::uint32_t> cachedAt;
+        std::uint32_t time;
+        std::uint32_t size;
+
+        CacheSimulation(const std::size_t vertexCount, const std::uint32_t size)
+            : cachedAt(vertexCount, 0), time(size + 1), size(size) {}
+
+        [[nodiscard]] bool cached(const std::uint32_t vertex) const { return time - cachedAt[vertex] <= size; }
+
+        /** 1 on a miss, which also brings the vertex in */
+        std::uint32_t access(const std::uint32_t vertex) {
+            if (cached(vertex))
+                return 0;
+            cachedAt[vertex] = time++;
+            return 1;
+        }
+
+        std::uint32_t accessTriangle(const std::uint32_t* triangle) {
+            return access(triangle[0]) + access(triangle[1]) + access(triangle[2]);
+        }
+
+        void flush() { time += size + 1; }
+    };
+
+    /** Twice the triangle's area along its normal */
+    glm::vec3 areaNormal(const std::span<const Vertex> vertices, const std::uint32_t* triangle) {
+        const glm::vec3& a = vertices[triangle[0]].position;
+        return glm::cross(vertices[triangle[1]].position - a, vertices[triangle[2]].position - a);
+    }
+}
+
+// analysis
+// ---------------------------------------------------------------------------------------------------------------------
+VertexCacheStats mesh_optimizer::analyzeVertexCache(const std::span<const std::uint32_t> indices, const std::size_t vertexCount,
+                                                    const std::uint32_t cacheSize) {
+    if (indices.size() < 3)
+        return {};
+
+    CacheSimulation cache(vertexCount, cacheSize);
+    std::vector<bool> used(vertexCount, false);
+    std::size_t misses = 0, uniqueVertices = 0;
+    for (const std::uint32_t index : indices) {
+        misses += cache.access(index);
+        if (!used[index]) {
+            used[index] = true;
+            uniqueVertices++;
+        }
+    }
+
+    return {
+        static_cast<float>(misses) / static_cast<float>(indices.size() / 3),
+        static_cast<float>(misses) / static_cast<float>(uniqueVertices),
+    };
+}
+
+float mesh_optimizer::analyzeOverdraw(const std::span<const Vertex> vertices, const std::span<const std::uint32_t> indices) {
+    constexpr int RESOLUTION = 256;
+    if (vertices.empty() || indices.size() < 3)
+        return 0.0f;
+
+    glm::vec3 min = vertices.front().position, max = min;
+    for (const Vertex& vertex : vertices) {
+        min = glm::min(min, vertex.position);
+        max = glm::max(max, vertex.position);
+    }
+
+    std::vector<float> depth(RESOLUTION * RESOLUTION);
+    float overdraw = 0.0f;
+    int views = 0;
+
+    for (int axis = 0; axis < 3; axis++) {
+        // looking down the axis: u and v span the screen, one scale for both keeps the projection undistorted
+        const int u = (axis + 1) % 3, v = (axis + 2) % 3;
+        const float extent = std::max(max[u] - min[u], max[v] - min[v]);
+        if (extent <= 0.0f)
+            continue;
+        const float scale = static_cast<float>(RESOLUTION - 1) / extent;
+
+        for (const float side : {1.0f, -1.0f}) {
+            std::ranges::fill(depth, std::numeric_limits<float>::infinity());
+            std::size_t shaded = 0;
+
+            for (std::size_t first = 0; first + 2 < indices.size(); first += 3) {
+                glm::vec3 corners[3];
+                for (int corner = 0; corner < 3; corner++) {
+                    const glm::vec3& position = vertices[indices[first + corner]].position;
+                    // viewed from the side end of the axis, nearer means further along it
+                    corners[corner] = {(position[u] - min[u]) * scale, (position[v] - min[v]) * scale, -side * position[axis]};
+                }
+
+                // counter-clockwise as seen from the viewer is front-facing; the rest is culled as the GPU would
+                float area = (corners[1].x - corners[0].x) * (corners[2].y - corners[0].y) -
+                             (corners[2].x - corners[0].x) * (corners[1].y - corners[0].y);
+                if (side * area <= 0.0f)
+                    continue;
+                if (area < 0.0f) {
+                    std::swap(corners[1], corners[2]);
+                    area = -area;
+                }
+
+                const int minX = std::max(0, static_cast<int>(std::ceil(std::min({corners[0].x, corners[1].x, corners[2].x}))));
+                const int minY = std::max(0, static_cast<int>(std::ceil(std::min({corners[0].y, corners[1].y, corners[2].y}))));
+                const int maxX = std::min(RESOLUTION - 1, static_cast<int>(std::max({corners[0].x, corners[1].x, corners[2].x})));
+                const int maxY = std::min(RESOLUTION - 1, static_cast<int>(std::max({corners[0].y, corners[1].y, corners[2].y})));
+
+                for (int y = minY; y <= maxY; y++) {
+                    for (int x = minX; x <= maxX; x++) {
+                        const auto px = static_cast<float>(x), py = static_cast<float>(y);
+                        const float w0 = (corners[2].x - corners[1].x) * (py - corners[1].y) - (corners[2].y - corners[1].y) * (px - corners[1].x);
+                        const float w1 = (corners[0].x - corners[2].x) * (py - corners[2].y) - (corners[0].y - corners[2].y) * (px - corners[2].x);
+                        const float w2 = (corners[1].x - corners[0].x) * (py - corners[0].y) - (corners[1].y - corners[0].y) * (px - corners[0].x);
+                        if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                            continue;
+
+                        // early depth test: only fragments that pass it are shaded
+                        const float z = (w0 * corners[0].z + w1 * corners[1].z + w2 * corners[2].z) / area;
+                        float& stored = depth[y * RESOLUTION + x];
+                        if (z < stored) {
+                            stored = z;
+                            shaded++;
+                        }
+                    }
+                }
+            }
+
+            const auto covered = std::ranges::count_if(depth, [](const float z) { return z != std::numeric_limits<float>::infinity(); });
+            if (covered > 0) {
+                overdraw += static_cast<float>(shaded) / static_cast<float>(covered);
+                views++;
+            }
+        }
+    }
+
+    return views > 0 ? overdraw / static_cast<float>(views) : 0.0f;
+}
+
+// optimization
+// ---------------------------------------------------------------------------------------------------------------------
+void mesh_optimizer::optimizeVertexCache(std::vector<std::uint32_t>& indices, const std::size_t vertexCount,
+                                         std::vector<std::uint32_t>* clusters) {
+    const std::size_t triangleCount = indices.size() / 3;
+    if (clusters)
+        clusters->clear();
+    if (triangleCount == 0)
+        return;
+
+    // triangles around every vertex, as offsets into one array
+    std::vector<std::uint32_t> live(vertexCount, 0);
+    for (const std::uint32_t index : indices)
+        live[index]++;
+
+    std::vector<std::uint32_t> adjacencyStart(vertexCount + 1, 0);
+    std::partial_sum(live.begin(), live.end(), adjacencyStart.begin() + 1);
+    std::vector<std::uint32_t> adjacency(indices.size());
+    {
+        std::vector<std::uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+        for (std::size_t index = 0; index < indices.size(); index++)
+            adjacency[fill[indices[index]]++] = static_cast<std::uint32_t>(index / 3);
+    }
+
+    std::vector<std::uint32_t> output;
+    output.reserve(indices.size());
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<std::uint32_t> deadEnds;
+    std::vector<std::uint32_t> candidates;
+    CacheSimulation cache(vertexCount, CACHE_SIZE);
+
+    // dead ends fall back to recently touched vertices, then to a scan of the input order
+    std::size_t scan = 0;
+    const auto skipDeadEnd = [&]() -> std::uint32_t {
+        while (!deadEnds.empty()) {
+            const std::uint32_t vertex = deadEnds.back();
+            deadEnds.pop_back();
+            if (live[vertex] > 0)
+                return vertex;
+        }
+        for (; scan < vertexCount; scan++) {
+            if (live[scan] > 0)
+                return static_cast<std::uint32_t>(scan);
+        }
+        return NONE;
+    };
+
+    std::uint32_t fan = skipDeadEnd();
+    bool newCluster = true;
+    while (fan != NONE) {
+        candidates.clear();
+        for (std::uint32_t entry = adjacencyStart[fan]; entry < adjacencyStart[fan + 1]; entry++) {
+            const std::uint32_t triangle = adjacency[entry];
+            if (emitted[triangle])
+                continue;
+
+            if (newCluster && clusters)
+                clusters->push_back(static_cast<std::uint32_t>(output.size() / 3));
+            newCluster = false;
+
+            for (int corner = 0; corner < 3; corner++) {
+                const std::uint32_t vertex = indices[triangle * 3 + corner];
+                output.push_back(vertex);
+                deadEnds.push_back(vertex);
+                candidates.push_back(vertex);
+                live[vertex]--;
+                cache.access(vertex);
+            }
+            emitted[triangle] = true;
+        }
+
+        // the next fan: the oldest candidate that will still be cached after its own triangles are emitted, since
+        // waiting any longer loses it; otherwise any candidate with triangles left
+        std::uint32_t next = NONE;
+        std::int64_t bestPriority = -1;
+        for (const std::uint32_t vertex : candidates) {
+            if (live[vertex] == 0)
+                continue;
+
+            std::int64_t priority = 0;
+            const std::int64_t age = cache.time - cache.cachedAt[vertex];
+            if (age + 2 * static_cast<std::int64_t>(live[vertex]) <= CACHE_SIZE)
+                priority = age;
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = vertex;
+            }
+        }
+
+        if (next == NONE) {
+            next = skipDeadEnd();
+            newCluster = true;
+        }
+        fan = next;
+    }
+
+    indices = std::move(output);
+}
+
+void mesh_optimizer::optimizeOverdraw(std::vector<std::uint32_t>& indices, const std::span<const Vertex> vertices,
+                                      const std::vector<std::uint32_t>& clusters, const float threshold) {
+    const std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || clusters.empty())
+        return;
+
+    // soft boundaries: within each run, cut as soon as the part since the last cut is about as cache efficient as
+    // the whole run; smaller clusters sort better and cost no more than threshold in ACMR
+    std::vector<std::uint32_t> starts;
+    CacheSimulation cache(vertices.size(), CACHE_SIZE);
+    for (std::size_t cluster = 0; cluster < clusters.size(); cluster++) {
+        const std::uint32_t begin = clusters[cluster];
+        const std::uint32_t end = cluster + 1 < clusters.size() ? clusters[cluster + 1] : static_cast<std::uint32_t>(triangleCount);
+
+        cache.flush();
+        std::uint32_t clusterMisses = 0;
+        for (std::uint32_t triangle = begin; triangle < end; triangle++)
+            clusterMisses += cache.accessTriangle(&indices[triangle * 3]);
+        const float limit = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+        cache.flush();
+        starts.push_back(begin);
+        std::uint32_t misses = 0;
+        for (std::uint32_t triangle = begin; triangle < end; triangle++) {
+            misses += cache.accessTriangle(&indices[triangle * 3]);
+            if (triangle + 1 < end && static_cast<float>(misses) <= limit * static_cast<float>(triangle + 1 - starts.back())) {
+                starts.push_back(triangle + 1);
+                misses = 0;
+                cache.flush();
+            }
+        }
+    }
+
+    // clusters facing away from the mesh centre are on the outside, drawing them first lets depth testing reject
+    // more of what lies behind
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    struct Cluster {
+        std::uint32_t begin;
+        std::uint32_t end;
+        glm::vec3 centroid{0.0f};
+        glm::vec3 normal{0.0f};
+        float area = 0.0f;
+        float sortKey = 0.0f;
+    };
+    std::vector<Cluster> sorted(starts.size());
+
+    for (std::size_t index = 0; index < starts.size(); index++) {
+        Cluster& cluster = sorted[index];
+        cluster.begin = starts[index];
+        cluster.end = index + 1 < starts.size() ? starts[index + 1] : static_cast<std::uint32_t>(triangleCount);
+
+        for (std::uint32_t triangle = cluster.begin; triangle < cluster.end; triangle++) {
+            const std::uint32_t* corners = &indices[triangle * 3];
+            const glm::vec3 normal = areaNormal(vertices, corners);
+            const float area = glm::length(normal);
+            const glm::vec3 centre = (vertices[corners[0]].position + vertices[corners[1]].position + vertices[corners[2]].position) / 3.0f;
+            cluster.centroid += centre * area;
+            cluster.normal += normal;
+            cluster.area += area;
+        }
+        meshCentroid += cluster.centroid;
+        meshArea += cluster.area;
+        if (cluster.area > 0.0f)
+            cluster.centroid /= cluster.area;
+    }
+    if (meshArea > 0.0f)
+        meshCentroid /= meshArea;
+
+    for (Cluster& cluster : sorted) {
+        const float length = glm::length(cluster.normal);
+        cluster.sortKey = length > 0.0f ? glm::dot(cluster.centroid - meshCentroid, cluster.normal / length) : 0.0f;
+    }
+    std::ranges::stable_sort(sorted, std::ranges::greater{}, &Cluster::sortKey);
+
+    std::vector<std::uint32_t> output;
+    output.reserve(indices.size());
+    for (const Cluster& cluster : sorted)
+        output.insert(output.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+    indices = std::move(output);
+}
+
+void mesh_optimizer::optimizeVertexFetch(MeshData& data) {
+    std::vector<std::uint32_t> remap(data.vertices.size(), NONE);
+    std::vector<Vertex> vertices;
+    vertices.reserve(data.vertices.size());
+
+    // vertices no index refers to are dropped on the way
+    for (std::uint32_t& index : data.indices) {
+        if (remap[index] == NONE) {
+            remap[index] = static_cast<std::uint32_t>(vertices.size());
+            vertices.push_back(data.vertices[index]);
+        }
+        index = remap[index];
+    }
+    data.vertices = std::move(vertices);
+}
+
+MeshOptimizationStats mesh_optimizer::optimize(MeshData& data, const bool measureOverdraw) {
+    MeshOptimizationStats stats;
+    stats.cacheBefore = analyzeVertexCache(data.indices, data.vertices.size());
+    if (measureOverdraw)
+        stats.overdrawBefore = analyzeOverdraw(data.vertices, data.indices);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::uint32_t> clusters;
+    optimizeVertexCache(data.indices, data.vertices.size(), &clusters);
+    optimizeOverdraw(data.indices, data.vertices, clusters);
+    optimizeVertexFetch(data);
+    stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    stats.cacheAfter = analyzeVertexCache(data.indices, data.vertices.size());
+    if (measureOverdraw)
+        stats.overdrawAfter = analyzeOverdraw(data.vertices, data.indices);
+    return stats;
+}
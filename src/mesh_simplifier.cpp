@@ -0,0 +1,263 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "mesh_simplifier.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace {
+    constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+    /**
+     * Symmetric 4x4 matrix summing area-weighted squared distances to a set of planes. Dividing by the summed area
+     * gives a mean squared distance, which stays in world units however many planes a vertex has merged.
+     */
+    struct Quadric {
+        double a2 = 0, ab = 0, ac = 0, ad = 0, b2 = 0, bc = 0, bd = 0, c2 = 0, cd = 0, d2 = 0;
+        double weight = 0;
+
+        static Quadric plane(const glm::dvec3& normal, const double d, const double weight) {
+            const glm::dvec3 n = normal * weight;
+            return {n.x * normal.x, n.x * normal.y, n.x * normal.z, n.x * d,
+                    n.y * normal.y, n.y * normal.z, n.y * d,
+                    n.z * normal.z, n.z * d, d * d * weight, weight};
+        }
+
+        Quadric& operator+=(const Quadric& other) {
+            a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad; b2 += other.b2;
+            bc += other.bc; bd += other.bd; c2 += other.c2; cd += other.cd; d2 += other.d2; weight += other.weight;
+            return *this;
+        }
+
+        [[nodiscard]] double error(const glm::dvec3& p) const {
+            if (weight <= 0.0)
+                return 0.0;
+            return (a2 * p.x * p.x + 2 * ab * p.x * p.y + 2 * ac * p.x * p.z + 2 * ad * p.x +
+                   b2 * p.y * p.y + 2 * bc * p.y * p.z + 2 * bd * p.y +
+                   c2 * p.z * p.z + 2 * cd * p.z + d2) / weight;
+        }
+    };
+
+    struct Collapse {
+        std::uint32_t from;
+        std::uint32_t to;
+        double cost;
+    };
+
+    std::uint64_t edgeKey(const std::uint32_t a, const std::uint32_t b) {
+        return static_cast<std::uint64_t>(std::min(a, b)) << 32 | std::max(a, b);
+    }
+
+    struct PositionHash {
+        std::size_t operator()(const glm::vec3& p) const {
+            std::size_t h = std::bit_cast<std::uint32_t>(p.x);
+            h = h * 0x9E3779B97F4A7C15ull ^ std::bit_cast<std::uint32_t>(p.y);
+            h = h * 0x9E3779B97F4A7C15ull ^ std::bit_cast<std::uint32_t>(p.z);
+            return h ^ (h >> 29);
+        }
+    };
+}
+
+SimplifiedMesh simplifyMesh(const MeshData& data, const std::size_t targetTriangles, const float maxError,
+                            const float attributeWeight) {
+    const std::size_t vertexCount = data.vertices.size();
+    std::vector<std::uint32_t> indices = data.indices;
+
+    // vertices split at seams share a position; quadrics and topology live per position
+    std::vector<std::uint32_t> positionOf(vertexCount);
+    std::vector<std::uint32_t> verticesAt;
+    {
+        std::unordered_map<glm::vec3, std::uint32_t, PositionHash> positions;
+        positions.reserve(vertexCount);
+        for (std::uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+            const auto [it, inserted] = positions.try_emplace(data.vertices[vertex].position, static_cast<std::uint32_t>(verticesAt.size()));
+            if (inserted)
+                verticesAt.push_back(0);
+            positionOf[vertex] = it->second;
+            verticesAt[it->second]++;
+        }
+    }
+
+    // seams: more than one vertex at a position. Borders: an edge only one triangle uses, found by sorting the keys
+    std::vector<bool> locked(verticesAt.size(), false);
+    for (std::size_t position = 0; position < verticesAt.size(); position++)
+        locked[position] = verticesAt[position] > 1;
+    {
+        std::vector<std::uint64_t> edges;
+        edges.reserve(indices.size());
+        for (std::size_t first = 0; first + 2 < indices.size(); first += 3) {
+            for (int corner = 0; corner < 3; corner++) {
+                const std::uint32_t a = positionOf[indices[first + corner]];
+                const std::uint32_t b = positionOf[indices[first + (corner + 1) % 3]];
+                if (a != b)
+                    edges.push_back(edgeKey(a, b));
+            }
+        }
+        std::ranges::sort(edges);
+        for (std::size_t edge = 0; edge < edges.size();) {
+            std::size_t end = edge + 1;
+            while (end < edges.size() && edges[end] == edges[edge])
+                end++;
+            if (end - edge == 1) {
+                locked[edges[edge] >> 32] = true;
+                locked[edges[edge] & 0xFFFFFFFFu] = true;
+            }
+            edge = end;
+        }
+    }
+
+    std::vector<Quadric> quadrics(verticesAt.size());
+    for (std::size_t first = 0; first + 2 < indices.size(); first += 3) {
+        const glm::dvec3 a = data.vertices[indices[first]].position;
+        const glm::dvec3 b = data.vertices[indices[first + 1]].position;
+        const glm::dvec3 c = data.vertices[indices[first + 2]].position;
+        const glm::dvec3 normal = glm::cross(b - a, c - a);
+        const double length = glm::length(normal);
+        if (length <= 0.0)
+            continue;
+
+        const Quadric plane = Quadric::plane(normal / length, -glm::dot(normal / length, a), length * 0.5);
+        for (int corner = 0; corner < 3; corner++)
+            quadrics[positionOf[indices[first + corner]]] += plane;
+    }
+
+    // passes of independent collapses, cheapest first, until the target or the error limit is reached
+    // -----------------------------------------------------------------------------------------------------------------
+    const double maxCost = static_cast<double>(maxError) * maxError;
+    double worstCost = 0.0;
+
+    std::vector<Collapse> collapses;
+    std::vector<std::uint32_t> remap(vertexCount);
+    std::vector<bool> touched(verticesAt.size());
+    std::vector<std::uint32_t> adjacencyStart(vertexCount + 1), adjacency;
+
+    while (indices.size() / 3 > targetTriangles) {
+        collapses.clear();
+        for (std::size_t first = 0; first + 2 < indices.size(); first += 3) {
+            for (int corner = 0; corner < 3; corner++) {
+                const std::uint32_t a = indices[first + corner];
+                const std::uint32_t b = indices[first + (corner + 1) % 3];
+                if (positionOf[a] == positionOf[b])
+                    continue;
+
+                const Vertex& va = data.vertices[a];
+                const Vertex& vb = data.vertices[b];
+                Quadric combined = quadrics[positionOf[a]];
+                combined += quadrics[positionOf[b]];
+                const glm::vec3 edge = vb.position - va.position;
+                const glm::vec3 normalChange = vb.normal - va.normal;
+                const glm::vec2 texCoordChange = vb.texCoords - va.texCoords;
+                const double attributeCost = static_cast<double>(attributeWeight) * glm::dot(edge, edge) *
+                                             (glm::dot(normalChange, normalChange) + glm::dot(texCoordChange, texCoordChange));
+
+                if (!locked[positionOf[a]])
+                    collapses.push_back({a, b, combined.error(vb.position) + attributeCost});
+                if (!locked[positionOf[b]])
+                    collapses.push_back({b, a, combined.error(va.position) + attributeCost});
+            }
+        }
+        std::ranges::sort(collapses, {}, &Collapse::cost);
+
+        // triangles around each vertex, for the flip test
+        std::ranges::fill(adjacencyStart, 0);
+        for (const std::uint32_t index : indices)
+            adjacencyStart[index + 1]++;
+        for (std::size_t vertex = 0; vertex < vertexCount; vertex++)
+            adjacencyStart[vertex + 1] += adjacencyStart[vertex];
+        adjacency.resize(indices.size());
+        {
+            std::vector<std::uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+            for (std::size_t index = 0; index < indices.size(); index++)
+                adjacency[fill[indices[index]]++] = static_cast<std::uint32_t>(index / 3);
+        }
+
+        for (std::uint32_t vertex = 0; vertex < vertexCount; vertex++)
+            remap[vertex] = vertex;
+        std::fill(touched.begin(), touched.end(), false);
+
+        // a collapse removes about two triangles; don't overshoot the target within one pass
+        const std::size_t budget = indices.size() / 3 - targetTriangles;
+        std::size_t removed = 0;
+        bool collapsed = false;
+
+        for (const Collapse& collapse : collapses) {
+            if (collapse.cost > maxCost || removed >= budget)
+                break;
+            if (touched[positionOf[collapse.from]] || touched[positionOf[collapse.to]])
+                continue;
+
+            // the triangles that survive must not turn over
+            const glm::vec3 target = data.vertices[collapse.to].position;
+            std::size_t degenerate = 0;
+            bool flips = false;
+            for (std::uint32_t entry = adjacencyStart[collapse.from]; entry < adjacencyStart[collapse.from + 1] && !flips; entry++) {
+                const std::uint32_t* triangle = &indices[adjacency[entry] * 3];
+                if (positionOf[triangle[0]] == positionOf[collapse.to] || positionOf[triangle[1]] == positionOf[collapse.to] ||
+                    positionOf[triangle[2]] == positionOf[collapse.to]) {
+                    degenerate++;
+                    continue;
+                }
+
+                glm::vec3 before[3], after[3];
+                for (int corner = 0; corner < 3; corner++) {
+                    before[corner] = data.vertices[triangle[corner]].position;
+                    after[corner] = triangle[corner] == collapse.from ? target : before[corner];
+                }
+                const glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+                const glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+                flips = glm::dot(normalBefore, normalAfter) <= 0.0f;
+            }
+            if (flips)
+                continue;
+
+            // freeze the whole one-ring for the rest of the pass, so every flip test above saw current geometry
+            for (std::uint32_t entry = adjacencyStart[collapse.from]; entry < adjacencyStart[collapse.from + 1]; entry++) {
+                const std::uint32_t* triangle = &indices[adjacency[entry] * 3];
+                for (int corner = 0; corner < 3; corner++)
+                    touched[positionOf[triangle[corner]]] = true;
+            }
+
+            remap[collapse.from] = collapse.to;
+            quadrics[positionOf[collapse.to]] += quadrics[positionOf[collapse.from]];
+            worstCost = std::max(worstCost, collapse.cost);
+            removed += degenerate;
+            collapsed = true;
+        }
+
+        if (!collapsed)
+            break;
+
+        std::size_t kept = 0;
+        for (std::size_t first = 0; first + 2 < indices.size(); first += 3) {
+            const std::uint32_t a = remap[indices[first]], b = remap[indices[first + 1]], c = remap[indices[first + 2]];
+            if (a == b || b == c || c == a)
+                continue;
+            indices[kept++] = a;
+            indices[kept++] = b;
+            indices[kept++] = c;
+        }
+        indices.resize(kept);
+    }
+
+    // keep only the vertices still referenced, in first-use order
+    SimplifiedMesh result;
+    std::vector<std::uint32_t> compact(vertexCount, NONE);
+    result.data.indices.reserve(indices.size());
+    for (const std::uint32_t index : indices) {
+        if (compact[index] == NONE) {
+            compact[index] = static_cast<std::uint32_t>(result.data.vertices.size());
+            result.data.vertices.push_back(data.vertices[index]);
+        }
+        result.data.indices.push_back(compact[index]);
+    }
+    result.error = static_cast<float>(std::sqrt(worstCost));
+    return result;
+}
@@ -0,0 +1,168 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "meshlet.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mesh_optimizer.h"
+
+namespace {
+    constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+}
+
+namespace meshlets {
+    MeshletMesh build(const MeshView& mesh, const std::size_t maxVertices, const std::size_t maxTriangles) {
+        const std::size_t triangleCount = mesh.indices.size() / 3;
+        const std::size_t vertexCount = mesh.vertices.size();
+
+        MeshletMesh result;
+        result.indices.reserve(triangleCount * 3);
+        result.meshlets.reserve(triangleCount / maxTriangles + 1);
+        result.bounds.reserve(triangleCount / maxTriangles + 1);
+
+        // triangles around each vertex
+        std::vector<std::uint32_t> adjacencyStart(vertexCount + 1, 0), adjacency(triangleCount * 3);
+        for (std::size_t index = 0; index < triangleCount * 3; index++)
+            adjacencyStart[mesh.indices[index] + 1]++;
+        for (std::size_t vertex = 0; vertex < vertexCount; vertex++)
+            adjacencyStart[vertex + 1] += adjacencyStart[vertex];
+        {
+            std::vector<std::uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+            for (std::size_t index = 0; index < triangleCount * 3; index++)
+                adjacency[fill[mesh.indices[index]]++] = static_cast<std::uint32_t>(index / 3);
+        }
+
+        std::vector<bool> emitted(triangleCount, false);
+        // meshlet a vertex was last added to, so membership needs no clearing between meshlets
+        std::vector<std::uint32_t> owner(vertexCount, NONE);
+        // position of a vertex within the meshlet being emitted, NONE outside of it
+        std::vector<std::uint32_t> localIndex(vertexCount, NONE);
+        std::vector<std::uint32_t> candidates, members, local, globals;
+
+        std::size_t seed = 0;
+        for (std::size_t done = 0; done < triangleCount;) {
+            while (emitted[seed])
+                seed++;
+
+            const auto id = static_cast<std::uint32_t>(result.meshlets.size());
+            Meshlet meshlet{static_cast<std::uint32_t>(result.indices.size()), 0, 0};
+            candidates.clear();
+            members.clear();
+
+            std::uint32_t next = static_cast<std::uint32_t>(seed);
+            while (next != NONE) {
+                emitted[next] = true;
+                members.push_back(next);
+                meshlet.triangleCount++;
+                for (int corner = 0; corner < 3; corner++) {
+                    const std::uint32_t vertex = mesh.indices[next * 3 + corner];
+                    if (owner[vertex] == id)
+                        continue;
+
+                    owner[vertex] = id;
+                    meshlet.vertexCount++;
+                    for (std::uint32_t entry = adjacencyStart[vertex]; entry < adjacencyStart[vertex + 1]; entry++) {
+                        if (!emitted[adjacency[entry]])
+                            candidates.push_back(adjacency[entry]);
+                    }
+                }
+                if (meshlet.triangleCount == maxTriangles)
+                    break;
+
+                // the neighbour adding the fewest vertices; one adding none can't be beaten
+                next = NONE;
+                std::uint32_t fewest = 4;
+                for (std::size_t candidate = 0; candidate < candidates.size() && fewest > 0;) {
+                    const std::uint32_t triangle = candidates[candidate];
+                    if (emitted[triangle]) {
+                        candidates[candidate] = candidates.back();
+                        candidates.pop_back();
+                        continue;
+                    }
+
+                    std::uint32_t added = 0;
+                    for (int corner = 0; corner < 3; corner++)
+                        added += owner[mesh.indices[triangle * 3 + corner]] != id;
+                    if (added < fewest && meshlet.vertexCount + added <= maxVertices) {
+                        next = triangle;
+                        fewest = added;
+                    }
+                    candidate++;
+                }
+            }
+
+            // growth order hops around the meshlet and the meshlet boundaries cut the optimizer's runs apart, so the
+            // triangles are put back in their original order and fanned again for the cache within the meshlet
+            std::ranges::sort(members);
+            local.clear();
+            globals.clear();
+            for (const std::uint32_t triangle : members) {
+                for (int corner = 0; corner < 3; corner++) {
+                    const std::uint32_t vertex = mesh.indices[triangle * 3 + corner];
+                    if (localIndex[vertex] == NONE) {
+                        localIndex[vertex] = static_cast<std::uint32_t>(globals.size());
+                        globals.push_back(vertex);
+                    }
+                    local.push_back(localIndex[vertex]);
+                }
+            }
+            mesh_optimizer::optimizeVertexCache(local, globals.size());
+            for (const std::uint32_t index : local)
+                result.indices.push_back(globals[index]);
+            for (const std::uint32_t vertex : globals)
+                localIndex[vertex] = NONE;
+
+            result.bounds.push_back(computeBounds(mesh.vertices, std::span(result.indices).subspan(meshlet.firstIndex)));
+            result.meshlets.push_back(meshlet);
+            done += meshlet.triangleCount;
+        }
+        return result;
+    }
+
+    MeshletBounds computeBounds(const std::span<const Vertex> vertices, const std::span<const std::uint32_t> indices) {
+        MeshletBounds bounds;
+        if (indices.empty())
+            return bounds;
+
+        // sphere around the box centre; a little looser than a minimal sphere, and far cheaper
+        glm::vec3 low(vertices[indices[0]].position), high = low;
+        for (const std::uint32_t index : indices) {
+            low = glm::min(low, vertices[index].position);
+            high = glm::max(high, vertices[index].position);
+        }
+        bounds.centre = 0.5f * (low + high);
+        for (const std::uint32_t index : indices)
+            bounds.radius = std::max(bounds.radius, glm::length(vertices[index].position - bounds.centre));
+
+        // cone around the average face normal, as wide as the normal furthest from it
+        std::vector<glm::vec3> normals;
+        normals.reserve(indices.size() / 3);
+        glm::vec3 sum(0.0f);
+        for (std::size_t first = 0; first + 2 < indices.size(); first += 3) {
+            const glm::vec3 a = vertices[indices[first]].position;
+            const glm::vec3 normal = glm::cross(vertices[indices[first + 1]].position - a, vertices[indices[first + 2]].position - a);
+            const float length = glm::length(normal);
+            if (length <= 0.0f)
+                continue;
+            normals.push_back(normal / length);
+            sum += normals.back();
+        }
+
+        const float sumLength = glm::length(sum);
+        if (normals.empty() || sumLength <= 0.0f)
+            return bounds;
+        bounds.coneAxis = sum / sumLength;
+
+        float minimumDot = 1.0f;
+        for (const glm::vec3& normal : normals)
+            minimumDot = std::min(minimumDot, glm::dot(normal, bounds.coneAxis));
+
+        // past about 84 degrees from the axis the cone would only reject meshlets seen from right behind
+        if (minimumDot > 0.1f)
+            bounds.coneCutoff = std::sqrt(1.0f - minimumDot * minimumDot);
+        return bounds;
+    }
+}
@@ -0,0 +1,130 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "meshlet_culler.h"
+
+#include <bit>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MESHLET_CULLER_SSE 1
+#endif
+
+Frustum Frustum::fromMatrix(const glm::mat4& matrix) {
+    // glm is column-major: row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i])
+    const glm::mat4 rows = glm::transpose(matrix);
+
+    Frustum frustum{};
+    frustum.planes = {
+        rows[3] + rows[0], rows[3] - rows[0], // left, right
+        rows[3] + rows[1], rows[3] - rows[1], // bottom, top
+        rows[3] + rows[2], rows[3] - rows[2], // near, far
+    };
+    for (glm::vec4& plane : frustum.planes)
+        plane /= glm::length(glm::vec3(plane));
+    return frustum;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+MeshletCuller::MeshletCuller(const MeshletMesh& mesh) : meshletCount(mesh.meshlets.size()), meshlets(mesh.meshlets) {
+    // padding lanes are never reported, their contents don't matter
+    const std::size_t padded = (meshletCount + 3) & ~std::size_t{3};
+    for (std::vector<float>* field : {&centreX, &centreY, &centreZ, &radius, &coneX, &coneY, &coneZ, &coneCutoff})
+        field->assign(padded, 0.0f);
+
+    for (std::size_t index = 0; index < meshletCount; index++) {
+        const MeshletBounds& bounds = mesh.bounds[index];
+        centreX[index] = bounds.centre.x;
+        centreY[index] = bounds.centre.y;
+        centreZ[index] = bounds.centre.z;
+        radius[index] = bounds.radius;
+        coneX[index] = bounds.coneAxis.x;
+        coneY[index] = bounds.coneAxis.y;
+        coneZ[index] = bounds.coneAxis.z;
+        coneCutoff[index] = bounds.coneCutoff;
+    }
+}
+
+void MeshletCuller::cull(const Mesh& mesh, const glm::vec3& cameraPosition, const Frustum& frustum,
+                         std::vector<DrawElementsIndirectCommand>& commands, const GLuint baseInstance) {
+    stats = {};
+    stats.meshlets = meshletCount;
+
+    const GLuint firstIndex = static_cast<GLuint>(mesh.indexOffset / (mesh.indexType == GL_UNSIGNED_SHORT ? 2 : 4));
+    const std::size_t firstCommand = commands.size();
+    // the meshlet the last command ends with, to extend it when the next one is visible too
+    std::size_t previous = meshletCount;
+
+    const auto emit = [&](const std::size_t index) {
+        const Meshlet& meshlet = meshlets[index];
+        if (previous + 1 == index && commands.size() > firstCommand) {
+            commands.back().count += meshlet.triangleCount * 3;
+        } else {
+            commands.push_back({meshlet.triangleCount * 3, 1, firstIndex + meshlet.firstIndex, mesh.baseVertex, baseInstance});
+        }
+        previous = index;
+        stats.visibleMeshlets++;
+        stats.visibleTriangles += meshlet.triangleCount;
+    };
+
+    for (const Meshlet& meshlet : meshlets)
+        stats.triangles += meshlet.triangleCount;
+
+#ifdef MESHLET_CULLER_SSE
+    const __m128 cameraX = _mm_set1_ps(cameraPosition.x);
+    const __m128 cameraY = _mm_set1_ps(cameraPosition.y);
+    const __m128 cameraZ = _mm_set1_ps(cameraPosition.z);
+
+    for (std::size_t first = 0; first < meshletCount; first += 4) {
+        const __m128 x = _mm_loadu_ps(&centreX[first]);
+        const __m128 y = _mm_loadu_ps(&centreY[first]);
+        const __m128 z = _mm_loadu_ps(&centreZ[first]);
+        const __m128 r = _mm_loadu_ps(&radius[first]);
+        const __m128 negativeR = _mm_sub_ps(_mm_setzero_ps(), r);
+
+        // inside or touching every plane
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const glm::vec4& plane : frustum.planes) {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+            distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, negativeR));
+        }
+
+        // and not entirely back-facing
+        const __m128 dx = _mm_sub_ps(x, cameraX);
+        const __m128 dy = _mm_sub_ps(y, cameraY);
+        const __m128 dz = _mm_sub_ps(z, cameraZ);
+        const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+        __m128 facing = _mm_mul_ps(dx, _mm_loadu_ps(&coneX[first]));
+        facing = _mm_add_ps(facing, _mm_mul_ps(dy, _mm_loadu_ps(&coneY[first])));
+        facing = _mm_add_ps(facing, _mm_mul_ps(dz, _mm_loadu_ps(&coneZ[first])));
+        const __m128 backFacing = _mm_cmpge_ps(facing, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&coneCutoff[first]), length), r));
+        visible = _mm_andnot_ps(backFacing, visible);
+
+        int mask = _mm_movemask_ps(visible);
+        if (meshletCount - first < 4)
+            mask &= (1 << (meshletCount - first)) - 1;
+        for (; mask != 0; mask &= mask - 1)
+            emit(first + static_cast<std::size_t>(std::countr_zero(static_cast<unsigned int>(mask))));
+    }
+#else
+    for (std::size_t index = 0; index < meshletCount; index++) {
+        const glm::vec3 centre(centreX[index], centreY[index], centreZ[index]);
+
+        bool visible = true;
+        for (const glm::vec4& plane : frustum.planes)
+            visible = visible && glm::dot(glm::vec3(plane), centre) + plane.w >= -radius[index];
+
+        const glm::vec3 view = centre - cameraPosition;
+        const glm::vec3 axis(coneX[index], coneY[index], coneZ[index]);
+        if (visible && glm::dot(view, axis) < coneCutoff[index] * glm::length(view) + radius[index])
+            emit(index);
+    }
+#endif
+
+    stats.commands = commands.size() - firstCommand;
+}
@@ -0,0 +1,483 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "obj_loader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "tangent_generator.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(const Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+    // "<path>.meshcache": this header, the vertices, the 32-bit indices, then one tangent per vertex
+    constexpr char CACHE_MAGIC[4] = {'O', 'B', 'J', 'C'};
+    // bumped whenever what is cached changes, version 2 holds optimized meshes, version 3 adds tangents and version 4
+    // replaces the NaN tangents version 3 could store for zero normals
+    constexpr std::uint32_t CACHE_VERSION = 4;
+
+    struct CacheHeader {
+        char magic[4];
+        std::uint32_t version;
+        // the OBJ the cache was built from, it is stale once either changes
+        std::uint64_t sourceSize;
+        std::int64_t sourceTime;
+        std::uint64_t vertexCount;
+        std::uint64_t indexCount;
+        std::uint64_t tangentCount;
+    };
+
+    static_assert(sizeof(CacheHeader) % alignof(Vertex) == 0, "vertices follow the header directly");
+
+    // one face corner as the OBJ spells it: 0-based position, texture coordinate and normal indices
+    struct Corner {
+        std::uint32_t position;
+        std::uint32_t texCoord;
+        std::uint32_t normal;
+
+        bool operator==(const Corner&) const = default;
+    };
+
+    // a run of whole lines, parsed by one job
+    struct Chunk {
+        std::string_view text;
+        // v, vt and vn lines in the chunk, then the number of each in all chunks before it
+        std::size_t positions = 0;
+        std::size_t texCoords = 0;
+        std::size_t normals = 0;
+        std::size_t firstPosition = 0;
+        std::size_t firstTexCoord = 0;
+        std::size_t firstNormal = 0;
+        // three per triangle, polygons already split into fans
+        std::vector<Corner> corners;
+        std::size_t malformedLines = 0;
+    };
+
+    bool isBlank(const char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    /** Call line(begin, end) for every line of text, without the line break */
+    template<typename F>
+    void forEachLine(const std::string_view text, F&& line) {
+        const char* cursor = text.data();
+        const char* const end = text.data() + text.size();
+        while (cursor < end) {
+            const auto* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+            if (!lineEnd)
+                lineEnd = end;
+            line(cursor, lineEnd);
+            cursor = lineEnd + 1;
+        }
+    }
+
+    /** "v ", "vt" or "vn" at the start of a line, or 0 */
+    char vertexTag(const char* line, const char* end) {
+        if (end - line < 2 || line[0] != 'v')
+            return 0;
+        if (isBlank(line[1]))
+            return 'v';
+        if ((line[1] == 't' || line[1] == 'n') && end - line > 2 && isBlank(line[2]))
+            return line[1];
+        return 0;
+    }
+
+    template<typename T>
+    const char* parseNumber(const char* cursor, const char* end, T& value) {
+        while (cursor < end && isBlank(*cursor))
+            cursor++;
+        const auto [next, error] = std::from_chars(cursor, end, value);
+        return error == std::errc{} ? next : nullptr;
+    }
+
+    template<int N>
+    bool parseVector(const char* cursor, const char* end, glm::vec<N, float>& out) {
+        for (int axis = 0; axis < N; axis++) {
+            cursor = parseNumber(cursor, end, out[axis]);
+            if (!cursor)
+                return false;
+        }
+        return true;
+    }
+
+    /** OBJ indices are 1-based, or negative counting back from the last element defined so far; 0 is invalid */
+    std::uint32_t resolveIndex(const long long index, const std::size_t definedSoFar, const std::size_t total) {
+        if (index == 0)
+            return NONE;
+        const long long resolved = index > 0 ? index - 1 : static_cast<long long>(definedSoFar) + index;
+        return resolved >= 0 && resolved < static_cast<long long>(total) ? static_cast<std::uint32_t>(resolved) : NONE;
+    }
+
+    // open addressing with linear probing; corners of one model number in the millions, std::unordered_map would
+    // spend most of the weld allocating nodes
+    class CornerTable {
+    public:
+        explicit CornerTable(const std::size_t expected) {
+            std::size_t capacity = 64;
+            while (capacity < expected * 2)
+                capacity *= 2;
+            keys.resize(capacity);
+            values.assign(capacity, NONE);
+        }
+
+        /** The vertex index of corner, which becomes next when it is new */
+        std::uint32_t findOrInsert(const Corner& corner, const std::uint32_t next) {
+            if ((count + 1) * 2 > keys.size())
+                rehash();
+
+            for (std::size_t slot = hash(corner) & (keys.size() - 1);; slot = (slot + 1) & (keys.size() - 1)) {
+                if (values[slot] == NONE) {
+                    keys[slot] = corner;
+                    values[slot] = next;
+                    count++;
+                    return next;
+                }
+                if (keys[slot] == corner)
+                    return values[slot];
+            }
+        }
+
+    private:
+        static std::size_t hash(const Corner& corner) {
+            std::uint64_t h = corner.position * 0x9E3779B97F4A7C15ull;
+            h ^= (corner.texCoord + 0x632BE59BD9B4E019ull + (h << 6) + (h >> 2)) * 0xBF58476D1CE4E5B9ull;
+            h ^= (corner.normal + 0x94D049BB133111EBull + (h << 6) + (h >> 2)) * 0x94D049BB133111EBull;
+            return static_cast<std::size_t>(h ^ (h >> 31));
+        }
+
+        void rehash() {
+            std::vector<Corner> oldKeys(keys.size() * 2);
+            std::vector<std::uint32_t> oldValues(keys.size() * 2, NONE);
+            oldKeys.swap(keys);
+            oldValues.swap(values);
+            count = 0;
+            for (std::size_t slot = 0; slot < oldKeys.size(); slot++) {
+                if (oldValues[slot] != NONE)
+                    findOrInsert(oldKeys[slot], oldValues[slot]);
+            }
+        }
+
+        std::vector<Corner> keys;
+        std::vector<std::uint32_t> values;
+        std::size_t count = 0;
+    };
+
+    /** Size and modification time of the OBJ, to tell whether a cache was built from this version of it */
+    bool sourceStamp(const std::string& path, std::uint64_t& size, std::int64_t& time) {
+        std::error_code error;
+        size = std::filesystem::file_size(path, error);
+        if (error)
+            return false;
+        time = static_cast<std::int64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+        return !error;
+    }
+}
+
+ObjLoader::ObjLoader(const std::size_t threadCount) : pool(threadCount) {}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+ObjMesh ObjLoader::load(const std::string& path) {
+    stats = {};
+    const auto start = Clock::now();
+
+    ObjMesh mesh;
+    if (loadCache(path, mesh)) {
+        stats.fromCache = true;
+        stats.triangles = mesh.view.indices.size() / 3;
+        stats.vertices = mesh.view.vertices.size();
+        stats.totalMs = millisecondsSince(start);
+        return mesh;
+    }
+
+    auto phase = Clock::now();
+    const MappedFile file(path);
+    if (file.empty()) {
+        std::cerr << "ERROR::OBJ_LOADER::FILE_NOT_SUCCESSFULLY_READ " << path << std::endl;
+        return {};
+    }
+    stats.readMs = millisecondsSince(phase);
+
+    // chunks
+    // -----------------------------------------------------------------------------------------------------------------
+    phase = Clock::now();
+    const std::string_view text = file.text();
+    const std::size_t chunkCount = std::max<std::size_t>(1, std::min(pool.getThreadCount() * 4, text.size() / 4096));
+
+    std::vector<Chunk> chunks(chunkCount);
+    std::size_t chunkStart = 0;
+    for (std::size_t index = 0; index < chunkCount; index++) {
+        // cut just after a line break at or past the even split point, so no line spans two chunks
+        std::size_t chunkEnd = text.size();
+        if (index + 1 < chunkCount) {
+            chunkEnd = std::max(chunkStart, text.size() * (index + 1) / chunkCount);
+            chunkEnd = text.find('\n', chunkEnd);
+            chunkEnd = chunkEnd == std::string_view::npos ? text.size() : chunkEnd + 1;
+        }
+        chunks[index].text = text.substr(chunkStart, chunkEnd - chunkStart);
+        chunkStart = chunkEnd;
+    }
+
+    // first pass: count vertex lines, so every chunk knows where its elements go and can resolve indices directly
+    pool.parallelFor(chunkCount, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            Chunk& chunk = chunks[index];
+            forEachLine(chunk.text, [&](const char* line, const char* lineEnd) {
+                switch (vertexTag(line, lineEnd)) {
+                    case 'v': chunk.positions++; break;
+                    case 't': chunk.texCoords++; break;
+                    case 'n': chunk.normals++; break;
+                    default: break;
+                }
+            });
+        }
+    });
+
+    std::size_t positionCount = 0, texCoordCount = 0, normalCount = 0;
+    for (Chunk& chunk : chunks) {
+        chunk.firstPosition = positionCount;
+        chunk.firstTexCoord = texCoordCount;
+        chunk.firstNormal = normalCount;
+        positionCount += chunk.positions;
+        texCoordCount += chunk.texCoords;
+        normalCount += chunk.normals;
+    }
+
+    std::vector<glm::vec3> positions(positionCount);
+    std::vector<glm::vec2> texCoords(texCoordCount);
+    std::vector<glm::vec3> normals(normalCount);
+
+    // second pass: parse into the shared arrays at each chunk's offsets and collect face corners
+    pool.parallelFor(chunkCount, [&](const std::size_t begin, const std::size_t end) {
+        std::vector<Corner> face;
+        for (std::size_t index = begin; index < end; index++) {
+            Chunk& chunk = chunks[index];
+            std::size_t position = chunk.firstPosition, texCoord = chunk.firstTexCoord, normal = chunk.firstNormal;
+            chunk.corners.reserve(chunk.text.size() / 8);
+
+            forEachLine(chunk.text, [&](const char* line, const char* lineEnd) {
+                bool parsed = true;
+                switch (vertexTag(line, lineEnd)) {
+                    case 'v': parsed = parseVector<3>(line + 1, lineEnd, positions[position++]); break;
+                    case 't': parsed = parseVector<2>(line + 2, lineEnd, texCoords[texCoord++]); break;
+                    case 'n': parsed = parseVector<3>(line + 2, lineEnd, normals[normal++]); break;
+                    default:
+                        if (lineEnd - line < 2 || line[0] != 'f' || !isBlank(line[1]))
+                            return;
+
+                        face.clear();
+                        for (const char* cursor = line + 1; parsed;) {
+                            while (cursor < lineEnd && isBlank(*cursor))
+                                cursor++;
+                            if (cursor == lineEnd)
+                                break;
+
+                            // v, v/vt, v//vn or v/vt/vn
+                            long long value = 0;
+                            cursor = parseNumber(cursor, lineEnd, value);
+                            if (!cursor) {
+                                parsed = false;
+                                break;
+                            }
+                            Corner corner{resolveIndex(value, position, positionCount), NONE, NONE};
+                            // an index that is written out but resolves to nothing makes the face malformed
+                            bool resolved = corner.position != NONE;
+                            if (cursor < lineEnd && *cursor == '/') {
+                                cursor++;
+                                if (cursor < lineEnd && *cursor != '/') {
+                                    cursor = parseNumber(cursor, lineEnd, value);
+                                    corner.texCoord = cursor ? resolveIndex(value, texCoord, texCoordCount) : NONE;
+                                    resolved = resolved && corner.texCoord != NONE;
+                                }
+                                if (cursor && cursor < lineEnd && *cursor == '/') {
+                                    cursor = parseNumber(cursor + 1, lineEnd, value);
+                                    corner.normal = cursor ? resolveIndex(value, normal, normalCount) : NONE;
+                                    resolved = resolved && corner.normal != NONE;
+                                }
+                            }
+                            parsed = cursor && resolved;
+                            face.push_back(corner);
+                        }
+
+                        parsed = parsed && face.size() >= 3;
+                        if (parsed) {
+                            for (std::size_t corner = 2; corner < face.size(); corner++)
+                                chunk.corners.insert(chunk.corners.end(), {face[0], face[corner - 1], face[corner]});
+                        }
+                        break;
+                }
+                if (!parsed)
+                    chunk.malformedLines++;
+            });
+        }
+    });
+    stats.parseMs = millisecondsSince(phase);
+
+    std::size_t cornerCount = 0, malformedLines = 0;
+    for (const Chunk& chunk : chunks) {
+        cornerCount += chunk.corners.size();
+        malformedLines += chunk.malformedLines;
+    }
+    if (malformedLines > 0)
+        std::cerr << "ERROR::OBJ_LOADER::MALFORMED_LINES " << malformedLines << " skipped in " << path << std::endl;
+    if (cornerCount == 0) {
+        std::cerr << "ERROR::OBJ_LOADER::NO_FACES " << path << std::endl;
+        return {};
+    }
+
+    // weld
+    // -----------------------------------------------------------------------------------------------------------------
+    phase = Clock::now();
+    std::vector<Corner> unique;
+    unique.reserve(positionCount + positionCount / 4);
+    mesh.data.indices.reserve(cornerCount);
+
+    CornerTable table(positionCount + positionCount / 4);
+    for (const Chunk& chunk : chunks) {
+        for (const Corner& corner : chunk.corners) {
+            const std::uint32_t vertex = table.findOrInsert(corner, static_cast<std::uint32_t>(unique.size()));
+            if (vertex == unique.size())
+                unique.push_back(corner);
+            mesh.data.indices.push_back(vertex);
+        }
+    }
+    chunks.clear();
+
+    // smooth normals for corners that name none, summed per position so texture seams don't split them; the cross
+    // product's length weighs each face by its area
+    std::vector<glm::vec3> smoothNormals;
+    if (std::ranges::any_of(unique, [](const Corner& corner) { return corner.normal == NONE; })) {
+        smoothNormals.assign(positionCount, glm::vec3(0.0f));
+        const std::vector<std::uint32_t>& indices = mesh.data.indices;
+        for (std::size_t first = 0; first + 2 < indices.size(); first += 3) {
+            const std::uint32_t a = unique[indices[first]].position;
+            const std::uint32_t b = unique[indices[first + 1]].position;
+            const std::uint32_t c = unique[indices[first + 2]].position;
+            const glm::vec3 faceNormal = glm::cross(positions[b] - positions[a], positions[c] - positions[a]);
+            smoothNormals[a] += faceNormal;
+            smoothNormals[b] += faceNormal;
+            smoothNormals[c] += faceNormal;
+        }
+    }
+
+    mesh.data.vertices.resize(unique.size());
+    pool.parallelFor(unique.size(), [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            const Corner& corner = unique[index];
+            Vertex& vertex = mesh.data.vertices[index];
+            vertex.position = positions[corner.position];
+            vertex.texCoords = corner.texCoord != NONE ? texCoords[corner.texCoord] : glm::vec2(0.0f);
+            if (corner.normal != NONE) {
+                vertex.normal = normals[corner.normal];
+            }
+            else {
+                const glm::vec3 sum = smoothNormals[corner.position];
+                vertex.normal = glm::dot(sum, sum) > 0.0f ? glm::normalize(sum) : glm::vec3(0.0f, 1.0f, 0.0f);
+            }
+        }
+    });
+    stats.weldMs = millisecondsSince(phase);
+
+    // authoring tools leave triangles in whatever order they were modelled; fix that once, before caching
+    phase = Clock::now();
+    stats.optimization = mesh_optimizer::optimize(mesh.data);
+    stats.optimizeMs = millisecondsSince(phase);
+
+    // after optimizing, which renumbers the vertices the tangents belong to
+    phase = Clock::now();
+    mesh.data.tangents = generateTangents(mesh.data.vertices, mesh.data.indices, pool);
+    stats.tangentMs = millisecondsSince(phase);
+
+    phase = Clock::now();
+    writeCache(path, mesh.data);
+    stats.cacheMs = millisecondsSince(phase);
+
+    mesh.view = MeshView(mesh.data);
+    stats.triangles = mesh.data.indices.size() / 3;
+    stats.vertices = mesh.data.vertices.size();
+    stats.totalMs = millisecondsSince(start);
+    return mesh;
+}
+
+// cache
+// ---------------------------------------------------------------------------------------------------------------------
+bool ObjLoader::loadCache(const std::string& path, ObjMesh& mesh) {
+    const auto start = Clock::now();
+
+    std::uint64_t sourceSize;
+    std::int64_t sourceTime;
+    if (!sourceStamp(path, sourceSize, sourceTime))
+        return false;
+
+    MappedFile file(path + ".meshcache");
+    const std::span<const std::byte> bytes = file.bytes();
+    if (bytes.size() < sizeof(CacheHeader))
+        return false;
+
+    CacheHeader header{};
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    const std::uint64_t expectedSize = sizeof(CacheHeader) + header.vertexCount * sizeof(Vertex) +
+                                       header.indexCount * sizeof(std::uint32_t) + header.tangentCount * sizeof(glm::vec4);
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION ||
+        header.sourceSize != sourceSize || header.sourceTime != sourceTime || bytes.size() != expectedSize)
+        return false;
+
+    // the mapping is page aligned and the header keeps all three arrays at their natural alignment
+    const auto* vertices = reinterpret_cast<const Vertex*>(bytes.data() + sizeof(CacheHeader));
+    const auto* indices = reinterpret_cast<const std::uint32_t*>(vertices + header.vertexCount);
+    const auto* tangents = reinterpret_cast<const glm::vec4*>(indices + header.indexCount);
+    mesh.view = MeshView({vertices, static_cast<std::size_t>(header.vertexCount)},
+                         {indices, static_cast<std::size_t>(header.indexCount)},
+                         {tangents, static_cast<std::size_t>(header.tangentCount)});
+    mesh.cache = std::move(file);
+
+    stats.cacheMs = millisecondsSince(start);
+    return true;
+}
+
+void ObjLoader::writeCache(const std::string& path, const MeshData& data) {
+    CacheHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.vertexCount = data.vertices.size();
+    header.indexCount = data.indices.size();
+    header.tangentCount = data.tangents.size();
+    if (!sourceStamp(path, header.sourceSize, header.sourceTime))
+        return;
+
+    // written aside and renamed into place, so a reader never maps half a cache
+    const std::string cachePath = path + ".meshcache";
+    const std::string temporaryPath = cachePath + ".tmp";
+    {
+        std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(data.vertices.data()), static_cast<std::streamsize>(data.vertices.size() * sizeof(Vertex)));
+        out.write(reinterpret_cast<const char*>(data.indices.data()), static_cast<std::streamsize>(data.indices.size() * sizeof(std::uint32_t)));
+        out.write(reinterpret_cast<const char*>(data.tangents.data()), static_cast<std::streamsize>(data.tangents.size() * sizeof(glm::vec4)));
+        if (!out) {
+            std::cerr << "ERROR::OBJ_LOADER::CACHE_NOT_WRITTEN " << cachePath << std::endl;
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, cachePath, error);
+    if (error)
+        std::cerr << "ERROR::OBJ_LOADER::CACHE_NOT_WRITTEN " << cachePath << ": " << error.message() << std::endl;
+}
@@ -0,0 +1,76 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "object_buffer.h"
+
+#include <algorithm>
+
+glm::mat3 normalMatrix(const glm::mat4& model) {
+    return glm::transpose(glm::inverse(glm::mat3(model)));
+}
+
+ObjectBuffer::ObjectBuffer(const std::size_t capacity)
+    : buffer(static_cast<GLsizeiptr>(std::max<std::size_t>(capacity, 1) * sizeof(ObjectData)), nullptr,
+             GL_DYNAMIC_STORAGE_BIT) {
+    objects.reserve(capacity);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::uint32_t ObjectBuffer::add(const glm::mat4& model, const std::uint32_t materialIndex) {
+    const auto index = static_cast<std::uint32_t>(objects.size());
+    objects.push_back({model, glm::mat3x4(normalMatrix(model)), materialIndex, {}});
+    markDirty(index);
+    return index;
+}
+
+void ObjectBuffer::setModel(const std::uint32_t index, const glm::mat4& model) {
+    objects[index].model = model;
+    objects[index].normalMatrix = glm::mat3x4(normalMatrix(model));
+    markDirty(index);
+}
+
+void ObjectBuffer::setMaterial(const std::uint32_t index, const std::uint32_t materialIndex) {
+    objects[index].materialIndex = materialIndex;
+    markDirty(index);
+}
+
+void ObjectBuffer::clear() {
+    objects.clear();
+    dirtyBegin = dirtyEnd = 0;
+}
+
+void ObjectBuffer::markDirty(const std::uint32_t index) {
+    if (dirtyBegin == dirtyEnd) {
+        dirtyBegin = index;
+        dirtyEnd = index + 1;
+        return;
+    }
+    dirtyBegin = std::min(dirtyBegin, index);
+    dirtyEnd = std::max(dirtyEnd, index + 1);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ObjectBuffer::update() {
+    uploadedBytes = 0;
+
+    const auto needed = static_cast<GLsizeiptr>(objects.size() * sizeof(ObjectData));
+    if (needed > buffer.size()) {
+        // immutable storage can't grow: a fresh buffer with room to spare, holding every object
+        buffer = Buffer(needed * 2, nullptr, GL_DYNAMIC_STORAGE_BIT);
+        dirtyBegin = 0;
+        dirtyEnd = static_cast<std::uint32_t>(objects.size());
+    }
+
+    // the driver orders this after earlier draws still reading the range, no fence needed at this rate of change
+    if (dirtyBegin != dirtyEnd) {
+        const std::size_t first = dirtyBegin * sizeof(ObjectData);
+        uploadedBytes = (dirtyEnd - dirtyBegin) * sizeof(ObjectData);
+        buffer.upload(static_cast<GLintptr>(first), static_cast<GLsizeiptr>(uploadedBytes), objects.data() + dirtyBegin);
+        dirtyBegin = dirtyEnd = 0;
+    }
+
+    buffer.bindBase(GL_SHADER_STORAGE_BUFFER, OBJECT_DATA_BINDING);
+}
@@ -0,0 +1,201 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "offset_allocator.h"
+
+#include <algorithm>
+#include <bit>
+
+OffsetAllocator::OffsetAllocator(const std::uint32_t size) : size(size) {
+    binHeads.fill(NO_SPACE);
+    if (size == 0)
+        return;
+
+    last = createNode(0, size);
+    insertFree(last);
+}
+
+// bins
+// ---------------------------------------------------------------------------------------------------------------------
+std::uint32_t OffsetAllocator::binRoundDown(const std::uint32_t size) {
+    // below 8 units every size has its own bin, above that 8 bins per power of two
+    constexpr std::uint32_t linear = 1u << MANTISSA_BITS;
+    if (size < linear)
+        return size;
+
+    const auto exponent = static_cast<std::uint32_t>(std::bit_width(size)) - 1;
+    const std::uint32_t mantissa = size >> (exponent - MANTISSA_BITS) & (linear - 1);
+    return (exponent - MANTISSA_BITS + 1) * linear + mantissa;
+}
+
+std::uint32_t OffsetAllocator::binRoundUp(const std::uint32_t size) {
+    constexpr std::uint32_t linear = 1u << MANTISSA_BITS;
+    const std::uint32_t bin = binRoundDown(size);
+    if (size < linear)
+        return bin;
+
+    // bits below the mantissa mean the bin also holds blocks smaller than size
+    const auto exponent = static_cast<std::uint32_t>(std::bit_width(size)) - 1;
+    const std::uint32_t lowBits = size & ((1u << (exponent - MANTISSA_BITS)) - 1);
+    return lowBits ? bin + 1 : bin;
+}
+
+std::uint32_t OffsetAllocator::findBin(const std::uint32_t first) const {
+    for (std::uint32_t word = first / 64; word < binMask.size(); word++) {
+        std::uint64_t bits = binMask[word];
+        if (word == first / 64)
+            bits &= ~0ull << (first % 64);
+        if (bits)
+            return word * 64 + static_cast<std::uint32_t>(std::countr_zero(bits));
+    }
+    return NO_SPACE;
+}
+
+// nodes
+// ---------------------------------------------------------------------------------------------------------------------
+std::uint32_t OffsetAllocator::createNode(const std::uint32_t offset, const std::uint32_t size) {
+    std::uint32_t index;
+    if (!unusedNodes.empty()) {
+        index = unusedNodes.back();
+        unusedNodes.pop_back();
+    }
+    else {
+        index = static_cast<std::uint32_t>(nodes.size());
+        nodes.emplace_back();
+    }
+
+    nodes[index] = Node{offset, size};
+    return index;
+}
+
+void OffsetAllocator::releaseNode(const std::uint32_t node) {
+    nodes[node] = Node{};
+    unusedNodes.push_back(node);
+}
+
+void OffsetAllocator::insertFree(const std::uint32_t node) {
+    const std::uint32_t bin = binRoundDown(nodes[node].size);
+
+    nodes[node].free = true;
+    nodes[node].previousFree = NO_SPACE;
+    nodes[node].nextFree = binHeads[bin];
+    if (binHeads[bin] != NO_SPACE)
+        nodes[binHeads[bin]].previousFree = node;
+    binHeads[bin] = node;
+
+    binMask[bin / 64] |= 1ull << (bin % 64);
+    freeSize += nodes[node].size;
+}
+
+void OffsetAllocator::removeFree(const std::uint32_t node) {
+    Node& removed = nodes[node];
+    const std::uint32_t bin = binRoundDown(removed.size);
+
+    if (removed.previousFree != NO_SPACE)
+        nodes[removed.previousFree].nextFree = removed.nextFree;
+    else
+        binHeads[bin] = removed.nextFree;
+    if (removed.nextFree != NO_SPACE)
+        nodes[removed.nextFree].previousFree = removed.previousFree;
+
+    if (binHeads[bin] == NO_SPACE)
+        binMask[bin / 64] &= ~(1ull << (bin % 64));
+
+    removed.free = false;
+    removed.previousFree = NO_SPACE;
+    removed.nextFree = NO_SPACE;
+    freeSize -= removed.size;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+OffsetAllocator::Allocation OffsetAllocator::allocate(const std::uint32_t size) {
+    if (size == 0)
+        return {};
+
+    const std::uint32_t bin = findBin(binRoundUp(size));
+    if (bin == NO_SPACE)
+        return {};
+
+    const std::uint32_t node = binHeads[bin];
+    removeFree(node);
+
+    // keep the front, hand the rest back; sequential allocations from one free block therefore stay contiguous
+    const std::uint32_t remainder = nodes[node].size - size;
+    if (remainder > 0) {
+        const std::uint32_t rest = createNode(nodes[node].offset + size, remainder);
+        nodes[rest].previous = node;
+        nodes[rest].next = nodes[node].next;
+        if (nodes[node].next != NO_SPACE)
+            nodes[nodes[node].next].previous = rest;
+        else
+            last = rest;
+        nodes[node].next = rest;
+        nodes[node].size = size;
+        insertFree(rest);
+    }
+
+    return {nodes[node].offset, node};
+}
+
+void OffsetAllocator::free(const Allocation allocation) {
+    if (!allocation.valid())
+        return;
+
+    std::uint32_t node = allocation.node;
+
+    // swallow a free neighbour on either side
+    if (const std::uint32_t previous = nodes[node].previous; previous != NO_SPACE && nodes[previous].free) {
+        removeFree(previous);
+        nodes[previous].size += nodes[node].size;
+        nodes[previous].next = nodes[node].next;
+        if (nodes[node].next != NO_SPACE)
+            nodes[nodes[node].next].previous = previous;
+        else
+            last = previous;
+        releaseNode(node);
+        node = previous;
+    }
+    if (const std::uint32_t next = nodes[node].next; next != NO_SPACE && nodes[next].free) {
+        removeFree(next);
+        nodes[node].size += nodes[next].size;
+        nodes[node].next = nodes[next].next;
+        if (nodes[next].next != NO_SPACE)
+            nodes[nodes[next].next].previous = node;
+        else
+            last = node;
+        releaseNode(next);
+    }
+
+    insertFree(node);
+}
+
+void OffsetAllocator::grow(const std::uint32_t newSize) {
+    if (newSize <= size)
+        return;
+
+    const std::uint32_t added = createNode(size, newSize - size);
+    nodes[added].previous = last;
+    if (last != NO_SPACE)
+        nodes[last].next = added;
+    last = added;
+    size = newSize;
+
+    // reuse free()'s merging: the new block is a just-released allocation as far as it is concerned
+    free({nodes[added].offset, added});
+}
+
+std::uint32_t OffsetAllocator::getLargestFree() const {
+    for (std::uint32_t word = static_cast<std::uint32_t>(binMask.size()); word-- > 0;) {
+        if (!binMask[word])
+            continue;
+
+        const std::uint32_t bin = word * 64 + 63 - static_cast<std::uint32_t>(std::countl_zero(binMask[word]));
+        std::uint32_t largest = 0;
+        for (std::uint32_t node = binHeads[bin]; node != NO_SPACE; node = nodes[node].nextFree)
+            largest = std::max(largest, nodes[node].size);
+        return largest;
+    }
+    return 0;
+}
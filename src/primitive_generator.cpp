@@ -0,0 +1,251 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "primitive_generator.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <string>
+#include <vector>
+
+#include "mesh_optimizer.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PRIMITIVE_GENERATOR_SSE 1
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /** Four floats, one SSE register where there is SSE */
+    struct Float4 {
+#ifdef PRIMITIVE_GENERATOR_SSE
+        __m128 value;
+
+        static Float4 load(const float* source) { return {_mm_loadu_ps(source)}; }
+        static Float4 broadcast(const float scalar) { return {_mm_set1_ps(scalar)}; }
+        void store(float* destination) const { _mm_storeu_ps(destination, value); }
+
+        friend Float4 operator+(const Float4 a, const Float4 b) { return {_mm_add_ps(a.value, b.value)}; }
+        friend Float4 operator-(const Float4 a, const Float4 b) { return {_mm_sub_ps(a.value, b.value)}; }
+        friend Float4 operator*(const Float4 a, const Float4 b) { return {_mm_mul_ps(a.value, b.value)}; }
+#else
+        float value[4];
+
+        static Float4 load(const float* source) { return {{source[0], source[1], source[2], source[3]}}; }
+        static Float4 broadcast(const float scalar) { return {{scalar, scalar, scalar, scalar}}; }
+        void store(float* destination) const { std::copy_n(value, 4, destination); }
+
+        friend Float4 operator+(const Float4 a, const Float4 b) {
+            return {{a.value[0] + b.value[0], a.value[1] + b.value[1], a.value[2] + b.value[2], a.value[3] + b.value[3]}};
+        }
+        friend Float4 operator-(const Float4 a, const Float4 b) {
+            return {{a.value[0] - b.value[0], a.value[1] - b.value[1], a.value[2] - b.value[2], a.value[3] - b.value[3]}};
+        }
+        friend Float4 operator*(const Float4 a, const Float4 b) {
+            return {{a.value[0] * b.value[0], a.value[1] * b.value[1], a.value[2] * b.value[2], a.value[3] * b.value[3]}};
+        }
+#endif
+    };
+
+    /**
+     * One array per vertex component. Every array has three floats of slack, so a row can be written four columns
+     * at a time: the lanes past its end land on the start of the next row, which overwrites them right after.
+     */
+    struct VertexStreams {
+        std::vector<float> px, py, pz, nx, ny, nz, u, v;
+
+        explicit VertexStreams(const std::size_t count) {
+            for (std::vector<float>* stream : {&px, &py, &pz, &nx, &ny, &nz, &u, &v})
+                stream->resize(count + 3);
+        }
+
+        void interleave(std::vector<Vertex>& vertices, const std::size_t count) const {
+            vertices.resize(count);
+            for (std::size_t index = 0; index < count; index++)
+                vertices[index] = {{px[index], py[index], pz[index]}, {nx[index], ny[index], nz[index]}, {u[index], v[index]}};
+        }
+    };
+
+    /** Per-column values of a lattice, padded like VertexStreams */
+    struct ColumnTable {
+        std::vector<float> u, sin, cos;
+
+        ColumnTable(const std::uint32_t columns, const std::uint32_t segments, const float turn) {
+            u.resize(columns + 3);
+            sin.resize(columns + 3);
+            cos.resize(columns + 3);
+            for (std::uint32_t column = 0; column < columns; column++) {
+                u[column] = static_cast<float>(column) / static_cast<float>(segments);
+                sin[column] = std::sin(u[column] * turn);
+                cos[column] = std::cos(u[column] * turn);
+            }
+        }
+    };
+
+    /** Two triangles per lattice quad; Sphere skips the one of each pole quad that collapses to a line */
+    void appendLatticeIndices(std::vector<std::uint32_t>& indices, const PrimitiveDesc& desc) {
+        const std::uint32_t columns = desc.columns + 1;
+        indices.reserve(static_cast<std::size_t>(desc.columns) * desc.rows * 6);
+
+        for (std::uint32_t row = 0; row < desc.rows; row++) {
+            for (std::uint32_t column = 0; column < desc.columns; column++) {
+                const std::uint32_t corner = row * columns + column;
+                const std::uint32_t next = corner + columns;
+                if (desc.type == PrimitiveType::Plane || desc.type == PrimitiveType::Grid) {
+                    // row grows towards -Z, so this winding faces +Y
+                    indices.insert(indices.end(), {corner, corner + 1, next + 1, next + 1, next, corner});
+                    continue;
+                }
+
+                // sphere and torus rows grow downwards over the outside, the same winding as primitives::sphere
+                if (desc.type != PrimitiveType::Sphere || row != 0)
+                    indices.insert(indices.end(), {corner, next, corner + 1});
+                if (desc.type != PrimitiveType::Sphere || row != desc.rows - 1)
+                    indices.insert(indices.end(), {corner + 1, next, next + 1});
+            }
+        }
+    }
+
+    /** Sanitised desc, so requests that generate the same mesh share one cache entry */
+    PrimitiveDesc normalize(PrimitiveDesc desc) {
+        const bool round = desc.type == PrimitiveType::Sphere || desc.type == PrimitiveType::Torus;
+        desc.columns = std::max(desc.columns, round ? 3u : 1u);
+        desc.rows = std::max(desc.rows, desc.type == PrimitiveType::Torus ? 3u : desc.type == PrimitiveType::Sphere ? 2u : 1u);
+        desc.minorRadius = desc.type == PrimitiveType::Torus ? std::clamp(desc.minorRadius, 0.001f, 0.25f) : 0.0f;
+        return desc;
+    }
+}
+
+// procedural
+// ---------------------------------------------------------------------------------------------------------------------
+MeshData procedural::generate(const PrimitiveDesc& requested) {
+    const PrimitiveDesc desc = normalize(requested);
+    const std::uint32_t columns = desc.columns + 1;
+    const std::uint32_t rows = desc.rows + 1;
+    const std::size_t vertexCount = static_cast<std::size_t>(columns) * rows;
+
+    constexpr float PI = std::numbers::pi_v<float>;
+    VertexStreams streams(vertexCount);
+    const ColumnTable table(columns, desc.columns, desc.type == PrimitiveType::Sphere || desc.type == PrimitiveType::Torus ? 2.0f * PI : 0.0f);
+
+    for (std::uint32_t row = 0; row < rows; row++) {
+        const float v = static_cast<float>(row) / static_cast<float>(desc.rows);
+        const std::size_t first = static_cast<std::size_t>(row) * columns;
+
+        // each row is a handful of scalars broadcast over the column lanes
+        Float4 rowX{}, rowY{}, rowZ{}, normalScale{}, normalY{}, texV{}, uScale{};
+        Float4 offsetX = Float4::broadcast(0.0f);
+        switch (desc.type) {
+            case PrimitiveType::Plane:
+            case PrimitiveType::Grid: {
+                texV = Float4::broadcast(desc.type == PrimitiveType::Grid ? v * static_cast<float>(desc.rows) : v);
+                uScale = Float4::broadcast(desc.type == PrimitiveType::Grid ? static_cast<float>(desc.columns) : 1.0f);
+                rowY = Float4::broadcast(0.0f);
+                rowZ = Float4::broadcast(0.5f - v);
+                offsetX = Float4::broadcast(-0.5f);
+                break;
+            }
+            case PrimitiveType::Sphere: {
+                // ring 0 is the north pole; the ring's circle has radius 0.5 sin(polar)
+                const float polar = v * PI;
+                normalScale = Float4::broadcast(std::sin(polar));
+                normalY = Float4::broadcast(std::cos(polar));
+                rowX = Float4::broadcast(0.5f * std::sin(polar));
+                rowY = Float4::broadcast(0.5f * std::cos(polar));
+                texV = Float4::broadcast(1.0f - v);
+                break;
+            }
+            case PrimitiveType::Torus: {
+                // row 0 is the outer equator; rows go down over the outside, under and back over the top
+                const float tube = v * 2.0f * PI;
+                const float majorRadius = 0.5f - desc.minorRadius;
+                normalScale = Float4::broadcast(std::cos(tube));
+                normalY = Float4::broadcast(-std::sin(tube));
+                rowX = Float4::broadcast(majorRadius + desc.minorRadius * std::cos(tube));
+                rowY = Float4::broadcast(-desc.minorRadius * std::sin(tube));
+                texV = Float4::broadcast(1.0f - v);
+                break;
+            }
+        }
+
+        for (std::uint32_t column = 0; column < columns; column += 4) {
+            const std::size_t index = first + column;
+            const Float4 u = Float4::load(&table.u[column]);
+
+            if (desc.type == PrimitiveType::Plane || desc.type == PrimitiveType::Grid) {
+                (u + offsetX).store(&streams.px[index]);
+                rowY.store(&streams.py[index]);
+                rowZ.store(&streams.pz[index]);
+                Float4::broadcast(0.0f).store(&streams.nx[index]);
+                Float4::broadcast(1.0f).store(&streams.ny[index]);
+                Float4::broadcast(0.0f).store(&streams.nz[index]);
+                (u * uScale).store(&streams.u[index]);
+                texV.store(&streams.v[index]);
+                continue;
+            }
+
+            // u increases counter-clockwise seen from above, as in primitives::sphere
+            const Float4 sin = Float4::load(&table.sin[column]);
+            const Float4 cos = Float4::load(&table.cos[column]);
+            (rowX * sin).store(&streams.px[index]);
+            rowY.store(&streams.py[index]);
+            (rowX * cos).store(&streams.pz[index]);
+            (normalScale * sin).store(&streams.nx[index]);
+            normalY.store(&streams.ny[index]);
+            (normalScale * cos).store(&streams.nz[index]);
+            u.store(&streams.u[index]);
+            texV.store(&streams.v[index]);
+        }
+    }
+
+    MeshData mesh;
+    streams.interleave(mesh.vertices, vertexCount);
+    appendLatticeIndices(mesh.indices, desc);
+    mesh_optimizer::optimize(mesh, false);
+    return mesh;
+}
+
+// PrimitiveCache
+// ---------------------------------------------------------------------------------------------------------------------
+std::size_t PrimitiveCache::KeyHash::operator()(const Key& key) const {
+    std::size_t h = static_cast<std::size_t>(key.desc.type);
+    for (const std::uint64_t value : {std::uint64_t{key.desc.columns}, std::uint64_t{key.desc.rows},
+                                      std::uint64_t{std::bit_cast<std::uint32_t>(key.desc.minorRadius)}, std::uint64_t{key.format}})
+        h = (h ^ value) * 0x100000001B3ull;
+    return h;
+}
+
+PrimitiveCache::PrimitiveCache(MeshLibrary& library) : library(library) {}
+
+const Mesh& PrimitiveCache::get(const PrimitiveDesc& desc, const VertexFormat format) {
+    const Key key{normalize(desc), format.key()};
+    if (const auto it = meshes.find(key); it != meshes.end()) {
+        stats.hits++;
+        return *it->second;
+    }
+    stats.misses++;
+
+    auto start = Clock::now();
+    const MeshData data = procedural::generate(key.desc);
+    stats.generateMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // a name nobody picks by hand, unique per key
+    constexpr const char* TYPE_NAMES[] = {"plane", "grid", "sphere", "torus"};
+    const std::string name = std::string("procedural:") + TYPE_NAMES[static_cast<int>(key.desc.type)] + ':' +
+                             std::to_string(key.desc.columns) + 'x' + std::to_string(key.desc.rows) + ':' +
+                             std::to_string(std::bit_cast<std::uint32_t>(key.desc.minorRadius)) + ':' +
+                             std::to_string(key.format);
+
+    start = Clock::now();
+    const Mesh& mesh = library.add(name, data, format);
+    stats.uploadMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    meshes.emplace(key, &mesh);
+    return mesh;
+}
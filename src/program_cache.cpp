@@ -0,0 +1,173 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "program_cache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "string_hash.h"
+
+namespace {
+    constexpr std::uint32_t CACHE_MAGIC = 0x50474F4C; // "LOGP"
+    constexpr std::uint32_t CACHE_VERSION = 1;
+
+    struct BlobHeader {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t key;
+        std::uint32_t format;
+        std::uint32_t length;
+        double compileMs;
+    };
+
+    std::string_view glString(const GLenum name) {
+        const auto* str = reinterpret_cast<const char*>(glGetString(name));
+        return str ? std::string_view(str) : std::string_view();
+    }
+}
+
+void ProgramBinaryCache::setDirectory(const std::filesystem::path& path) {
+    directory = path;
+}
+
+void ProgramBinaryCache::setEnabled(const bool value) {
+    enabled = value;
+}
+
+/** Hash the sources together with the driver identity; any change there produces a new key */
+std::uint64_t ProgramBinaryCache::makeKey(const std::initializer_list<std::string_view> sources) {
+    std::uint64_t hash = FNV_OFFSET_BASIS;
+    for (const std::string_view source : sources) {
+        hash = hashString(source, hash);
+        hash = hashString("\x1f", hash); // separator, so moving text between stages changes the key
+    }
+
+    hash = hashString(glString(GL_VENDOR), hash);
+    hash = hashString(glString(GL_RENDERER), hash);
+    hash = hashString(glString(GL_VERSION), hash);
+    return hash;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool ProgramBinaryCache::load(const GLuint program, const std::uint64_t key) {
+    if (!isAvailable())
+        return false;
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::filesystem::path path = pathFor(key);
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        stats.misses++;
+        return false;
+    }
+
+    BlobHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    // the blob must be exactly what the header claims, so a corrupted length can't make us allocate it
+    std::error_code sizeError;
+    const std::uintmax_t fileSize = std::filesystem::file_size(path, sizeError);
+    const bool lengthMatches = !sizeError && fileSize >= sizeof(BlobHeader) && fileSize - sizeof(BlobHeader) == header.length;
+
+    std::vector<char> binary;
+    if (file && lengthMatches && header.magic == CACHE_MAGIC && header.version == CACHE_VERSION && header.key == key) {
+        binary.resize(header.length);
+        file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+    }
+    file.close();
+
+    // truncated or foreign file, or the driver no longer accepts the blob: drop it and compile instead
+    GLint linked = GL_FALSE;
+    if (!binary.empty() && file) {
+        glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    }
+
+    if (!linked) {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        stats.rejected++;
+        stats.misses++;
+        return false;
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    const double loadMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    stats.hits++;
+    stats.loadMs += loadMs;
+    stats.savedMs += header.compileMs - loadMs;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ProgramBinaryCache::store(const GLuint program, const std::uint64_t key, const double compileMs) {
+    stats.compileMs += compileMs;
+    if (!isAvailable())
+        return;
+
+    GLint linked = GL_FALSE;
+    GLint length = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (!linked || length <= 0)
+        return;
+
+    std::vector<char> binary(static_cast<std::size_t>(length));
+    GLenum format = 0;
+    glGetProgramBinary(program, length, nullptr, &format, binary.data());
+
+    const BlobHeader header{CACHE_MAGIC, CACHE_VERSION, key, format, static_cast<std::uint32_t>(length), compileMs};
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    // write next to the final name and rename, so a crash never leaves a half-written blob behind
+    const std::filesystem::path path = pathFor(key);
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+    file.close();
+
+    if (!file) {
+        std::cerr << "ERROR::PROGRAM_CACHE::WRITE_FAILED " << temporary << std::endl;
+        std::filesystem::remove(temporary, error);
+        return;
+    }
+    std::filesystem::rename(temporary, path, error);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool ProgramBinaryCache::isAvailable() {
+    if (!enabled)
+        return false;
+
+    if (supported < 0) {
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        supported = formats > 0 ? 1 : 0;
+    }
+    return supported == 1;
+}
+
+std::filesystem::path ProgramBinaryCache::pathFor(const std::uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return directory / name;
+}
@@ -4,164 +4,217 @@
 
 #include "shader.h"
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 #include <string>
-#include <sstream>
-#include <fstream>
+#include <utility>
 
 #include <glad/glad.h>
 
-Shader::Shader(const char *vertexPath, const char *fragmentPath) {
-    // 1. retrieve the vertex/fragment source code from the filepath
-    std::string vertexCode;
-    std::string fragmentCode;
-
-    try {
-        std::ifstream fShaderFile;
-        std::ifstream vShaderFile;
-
-        // open files
-        vShaderFile.open(vertexPath);
-        fShaderFile.open(fragmentPath);
-        std::stringstream vShaderStream, fShaderStream;
-
-        // read files
-        vShaderStream << vShaderFile.rdbuf();
-        fShaderStream << fShaderFile.rdbuf();
-
-        // convert stream info to str
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
-    } catch (std::ifstream::failure &e) {
-        std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ" << e.what() << std::endl;
+#include "gl_state.h"
+#include "shader_preprocessor.h"
+
+Shader::Shader(const char *vertexPath, const char *fragmentPath, const ShaderBuild mode, std::string defines) :
+vertexPath(vertexPath), fragmentPath(fragmentPath), defines(std::move(defines)) {
+    // 1. retrieve the vertex/fragment source code from the filepath, with every #include expanded
+    PreprocessedSource vertexSource = ShaderPreprocessor::expand(vertexPath, this->defines);
+    PreprocessedSource fragmentSource = ShaderPreprocessor::expand(fragmentPath, this->defines);
+
+    dependencies = vertexSource.files;
+    for (const std::string& file : fragmentSource.files) {
+        if (std::find(dependencies.begin(), dependencies.end(), file) == dependencies.end())
+            dependencies.push_back(file);
     }
 
-    const char *vShaderCode = vertexCode.c_str();
-    const char *fShaderCode = fragmentCode.c_str();
+    // 2. each stage is looked up by its expanded source; only stages nobody has built yet are compiled, and those
+    // may still come from the program binary cache
+    vertex = ShaderStage::get(GL_VERTEX_SHADER, std::move(vertexSource));
+    fragment = ShaderStage::get(GL_FRAGMENT_SHADER, std::move(fragmentSource));
 
-    // 2. compile shader
-    unsigned int vertex, fragment;
+    // 3. the pipeline is filled in once both stages have linked
+    glCreateProgramPipelines(1, &pipeline);
 
-    // vert shader
-    vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vShaderCode, nullptr);
-    glCompileShader(vertex);
-    checkCompileErrors(static_cast<GLint>(vertex), "VERTEX");
+    if (mode == ShaderBuild::Blocking)
+        wait();
+}
 
-    // frag shader
-    fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fShaderCode, nullptr);
-    glCompileShader(fragment);
-    checkCompileErrors(static_cast<GLint>(fragment), "FRAGMENT");
+Shader::~Shader() {
+    GLState::forgetPipeline(pipeline);
+    glDeleteProgramPipelines(1, &pipeline);
+}
+
+ShaderStatus Shader::poll() const {
+    if (status != ShaderStatus::Pending)
+        return status;
 
-    // 3. create the program
-    program = glCreateProgram();
-    glAttachShader(program, vertex);
-    glAttachShader(program, fragment);
-    glLinkProgram(program);
-    checkCompileErrors(static_cast<GLint>(program), "PROGRAM");
+    // poll both, so the second stage is finished in the same call if it is already done
+    const ShaderStatus vertexStatus = vertex->poll();
+    const ShaderStatus fragmentStatus = fragment->poll();
+    if (vertexStatus == ShaderStatus::Pending || fragmentStatus == ShaderStatus::Pending)
+        return ShaderStatus::Pending;
 
-    // delete shaders; already linked to program
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
+    finishBuild();
+    return status;
 }
 
-Shader::~Shader() {
-    glDeleteProgram(program);
-}
-
-void Shader::checkCompileErrors(const GLint shader, const std::string &type) {
-    GLint success;
-    GLchar info[1024];
-    if (type != "PROGRAM") {
-        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-        if (!success) {
-            glGetShaderInfoLog(shader, 1024, nullptr, info);
-            std::cerr << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << info << "\n -- -------------------------------------- --\n";
-        }
+void Shader::wait() const {
+    if (status != ShaderStatus::Pending)
+        return;
+
+    vertex->wait();
+    fragment->wait();
+    finishBuild();
+}
+
+bool Shader::reload() {
+    wait();
+
+    // build the replacement next to the current program, so a broken edit never leaves us without one; a stage
+    // whose source did not change is shared with the current program rather than rebuilt
+    Shader replacement(vertexPath.c_str(), fragmentPath.c_str(), ShaderBuild::Blocking, defines);
+    if (replacement.status != ShaderStatus::Ready) {
+        std::cerr << "ERROR::SHADER::RELOAD_FAILED keeping the previous program for " << vertexPath << ", " << fragmentPath << std::endl;
+        return false;
     }
-    else {
-        glGetProgramiv(shader, GL_LINK_STATUS, &success);
-        if (!success) {
-            glGetProgramInfoLog(shader, 1024, nullptr, info);
-            std::cerr << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << info << "\n -- ----------------------------------------- --\n";
-        }
+
+    // take over the new pipeline; the replacement releases the old one on its way out
+    std::swap(pipeline, replacement.pipeline);
+    std::swap(vertex, replacement.vertex);
+    std::swap(fragment, replacement.fragment);
+    std::swap(dependencies, replacement.dependencies);
+    status = ShaderStatus::Ready;
+    generation++;
+    return true;
+}
+
+void Shader::finishBuild() const {
+    if (vertex->poll() != ShaderStatus::Ready || fragment->poll() != ShaderStatus::Ready) {
+        status = ShaderStatus::Failed;
+        return;
     }
+
+    glUseProgramStages(pipeline, GL_VERTEX_SHADER_BIT, vertex->program);
+    glUseProgramStages(pipeline, GL_FRAGMENT_SHADER_BIT, fragment->program);
+
+#ifndef NDEBUG
+    // interface mismatches between separately linked stages only show up here
+    glValidateProgramPipeline(pipeline);
+    GLint valid = GL_FALSE;
+    glGetProgramPipelineiv(pipeline, GL_VALIDATE_STATUS, &valid);
+    if (!valid) {
+        GLchar info[1024];
+        glGetProgramPipelineInfoLog(pipeline, 1024, nullptr, info);
+        std::cerr << "ERROR::SHADER::PIPELINE_VALIDATION " << vertexPath << ", " << fragmentPath << "\n" << info << std::endl;
+    }
+#endif
+
+    status = ShaderStatus::Ready;
+}
+
+GLuint Shader::getStageProgram(const GLenum stage) const {
+    wait();
+    return stage == GL_VERTEX_SHADER ? vertex->program : fragment->program;
+}
+
+void Shader::reportTypeMismatch(const std::string_view name, const GLenum glslType) {
+    std::cerr << "ERROR::SHADER::UNIFORM_TYPE_MISMATCH: \"" << name << "\" is declared with GL type 0x"
+              << std::hex << glslType << std::dec << " in GLSL" << std::endl;
+    assert(false && "Uniform<T> does not match the GLSL declaration");
 }
 
 /** Activate the shader */
 void Shader::use() const {
-    glUseProgram(program);
+    wait();
+
+    // a bound program takes precedence over the bound pipeline
+    GLState::useProgram(0);
+    GLState::bindProgramPipeline(pipeline);
+}
+
+/** Location of an active uniform, or -1 when the linker optimised it out */
+GLint Shader::getUniformLocation(const std::string_view name) const {
+    wait();
+    for (ShaderStage* stage : stages()) {
+        if (const GLint location = stage->getUniforms().location(name); location >= 0)
+            return location;
+    }
+    return -1;
+}
+
+std::size_t Shader::getUniformCount() const {
+    wait();
+    return vertex->getUniforms().size() + fragment->getUniforms().size();
 }
 
 // Utility uniform functions
 // ---------------------------------------------------------------------------------------------------------------------
-void Shader::setBool(const std::string &name, const bool value) const {
-    glUniform1i(glGetUniformLocation(program, name.c_str()), static_cast<int>(value));
+void Shader::setBool(const std::string_view name, const bool value) const {
+    upload(name, value);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Shader::setInt(const std::string &name, const int value) const {
-    glUniform1i(glGetUniformLocation(program, name.c_str()), value);
+void Shader::setInt(const std::string_view name, const int value) const {
+    upload(name, value);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Shader::setFloat(const std::string &name, const float value) const {
-    glUniform1f(glGetUniformLocation(program, name.c_str()), value);
+void Shader::setFloat(const std::string_view name, const float value) const {
+    upload(name, value);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Shader::setVec2(const std::string &name, const glm::vec2 &value) const {
-    glUniform2fv(glGetUniformLocation(program, name.c_str()), 1, &value[0]);
+void Shader::setVec2(const std::string_view name, const glm::vec2 &value) const {
+    upload(name, value);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Shader::setVec2(const std::string &name, float x, float y) const {
-    glUniform2f(glGetUniformLocation(program, name.c_str()), x, y);
+void Shader::setVec2(const std::string_view name, float x, float y) const {
+    upload(name, glm::vec2(x, y));
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Shader::setVec3(const std::string &name, const glm::vec3 &value) const {
-    glUniform3fv(glGetUniformLocation(program, name.c_str()), 1, &value[0]);
+void Shader::setVec3(const std::string_view name, const glm::vec3 &value) const {
+    upload(name, value);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Shader::setVec3(const std::string &name, float x, float y, float z) const {
-    glUniform3f(glGetUniformLocation(program, name.c_str()), x, y, z);
+void Shader::setVec3(const std::string_view name, float x, float y, float z) const {
+    upload(name, glm::vec3(x, y, z));
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Shader::setVec4(const std::string &name, const glm::vec4 &value) const {
-    glUniform4fv(glGetUniformLocation(program, name.c_str()), 1, &value[0]);
+void Shader::setVec4(const std::string_view name, const glm::vec4 &value) const {
+    upload(name, value);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Shader::setVec4(const std::string &name, float x, float y, float z, float w) const {
-    glUniform4f(glGetUniformLocation(program, name.c_str()), x, y, z, w);
+void Shader::setVec4(const std::string_view name, float x, float y, float z, float w) const {
+    upload(name, glm::vec4(x, y, z, w));
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Shader::setMat2(const std::string &name, const glm::mat2 &mat) const {
-    glUniformMatrix2fv(glGetUniformLocation(program, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::setMat2(const std::string_view name, const glm::mat2 &mat) const {
+    upload(name, mat);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Shader::setMat3(const std::string &name, const glm::mat3 &mat) const {
-    glUniformMatrix3fv(glGetUniformLocation(program, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::setMat3(const std::string_view name, const glm::mat3 &mat) const {
+    upload(name, mat);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 
-void Shader::setMat4(const std::string &name, const glm::mat4 &mat) const {
-    glUniformMatrix4fv(glGetUniformLocation(program, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::setMat4(const std::string_view name, const glm::mat4 &mat) const {
+    upload(name, mat);
 }
@@ -0,0 +1,66 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "shader_library.h"
+
+#include <iostream>
+#include <utility>
+
+#include "shader_watcher.h"
+#include "string_hash.h"
+
+ShaderLibrary::ShaderLibrary(ShaderWatcher* watcher) : watcher(watcher) {}
+
+ShaderLibrary::~ShaderLibrary() {
+    if (!watcher)
+        return;
+
+    for (const auto& [key, shader] : variants)
+        watcher->unwatch(*shader);
+}
+
+void ShaderLibrary::add(const std::string_view name, std::string vertexPath, std::string fragmentPath, const ShaderBuild mode) {
+    const auto [it, inserted] = names.try_emplace(hashString(name), static_cast<std::uint32_t>(sources.size()));
+    if (!inserted) {
+        std::cerr << "ERROR::SHADER_LIBRARY::DUPLICATE_NAME " << name << std::endl;
+        return;
+    }
+    sources.push_back({std::move(vertexPath), std::move(fragmentPath), mode});
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+Shader* ShaderLibrary::get(const std::string_view name, const ShaderFeatures features) {
+    const auto found = names.find(hashString(name));
+    if (found == names.end()) {
+        std::cerr << "ERROR::SHADER_LIBRARY::UNKNOWN_NAME " << name << std::endl;
+        return nullptr;
+    }
+
+    const std::uint64_t key = static_cast<std::uint64_t>(found->second) << 32 | features.mask;
+    if (const auto variant = variants.find(key); variant != variants.end())
+        return variant->second.get();
+
+    // first request for this permutation: build it now, the program binary cache makes repeat runs cheap
+    const Source& source = sources[found->second];
+    auto shader = std::make_unique<Shader>(source.vertexPath.c_str(), source.fragmentPath.c_str(), source.mode, definesFor(features));
+    if (watcher)
+        watcher->watch(*shader);
+
+    return variants.emplace(key, std::move(shader)).first->second.get();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::string ShaderLibrary::definesFor(const ShaderFeatures features) {
+    std::string defines;
+    for (std::size_t bit = 0; bit < SHADER_FEATURE_NAMES.size(); bit++) {
+        if (features.mask & (1u << bit)) {
+            defines += "#define ";
+            defines += SHADER_FEATURE_NAMES[bit];
+            defines += '\n';
+        }
+    }
+    return defines;
+}
@@ -0,0 +1,162 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "shader_preprocessor.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <system_error>
+
+namespace {
+    constexpr int MAX_INCLUDE_DEPTH = 32;
+
+    std::string_view trimLeft(std::string_view line) {
+        while (!line.empty() && (line.front() == ' ' || line.front() == '\t'))
+            line.remove_prefix(1);
+        return line;
+    }
+}
+
+PreprocessedSource ShaderPreprocessor::expand(const std::string& path, const std::string_view defines) {
+    PreprocessedSource result;
+    std::unordered_set<std::string> included;
+    expandInto(canonicalPath(path), result, included, 0);
+
+    if (defines.empty() || !result.code.starts_with("#version"))
+        return result;
+
+    // only inject what this source mentions, so a stage that ignores a feature expands to the same text, and is
+    // shared, for every permutation
+    std::string used;
+    for (std::size_t begin = 0; begin < defines.size();) {
+        std::size_t end = defines.find('\n', begin);
+        end = end == std::string_view::npos ? defines.size() : end + 1;
+
+        const std::string_view line = defines.substr(begin, end - begin);
+        const std::string_view name = trimLeft(line.substr(std::min(line.size(), std::string_view("#define").size())));
+        const std::string_view token = name.substr(0, name.find_first_of(" \t\n"));
+        if (token.empty() || result.code.find(token) != std::string::npos)
+            used += line;
+
+        begin = end;
+    }
+
+    if (!used.empty()) {
+        if (!used.ends_with('\n'))
+            used += '\n';
+        const std::size_t firstLine = result.code.find('\n') + 1;
+        result.code.insert(firstLine, used + "#line 2 0\n");
+    }
+    return result;
+}
+
+void ShaderPreprocessor::invalidate(const std::string& path) {
+    chunks.erase(canonicalPath(path));
+}
+
+std::string ShaderPreprocessor::canonicalPath(const std::string& path) {
+    std::error_code error;
+    const std::filesystem::path canonical = std::filesystem::weakly_canonical(path, error);
+    return error ? path : canonical.string();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** Read and split a file into segments, or return the memoized result */
+const ShaderPreprocessor::Chunk& ShaderPreprocessor::load(const std::string& file) {
+    if (const auto it = chunks.find(file); it != chunks.end())
+        return it->second;
+
+    Chunk& chunk = chunks[file];
+
+    std::ifstream stream(file);
+    if (!stream) {
+        std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ " << file << std::endl;
+        return chunk;
+    }
+    chunk.found = true;
+
+    const std::filesystem::path directory = std::filesystem::path(file).parent_path();
+
+    Segment text;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(stream, line)) {
+        lineNumber++;
+        const std::string_view directive = trimLeft(line);
+
+        if (directive.starts_with("#pragma") && trimLeft(directive.substr(7)).starts_with("once")) {
+            chunk.once = true;
+            text.text += '\n'; // keep line numbers intact
+            continue;
+        }
+
+        if (directive.starts_with("#include")) {
+            const std::size_t open = directive.find('"');
+            const std::size_t close = directive.find('"', open + 1);
+            if (open == std::string_view::npos || close == std::string_view::npos) {
+                text.text += "#error malformed #include\n";
+                continue;
+            }
+
+            // flush the text gathered so far, then record the include itself
+            if (!text.text.empty())
+                chunk.segments.push_back(std::move(text));
+
+            const std::string_view name = directive.substr(open + 1, close - open - 1);
+            chunk.segments.push_back({{}, canonicalPath((directory / name).string()), lineNumber});
+
+            text = Segment{{}, {}, lineNumber + 1};
+            continue;
+        }
+
+        text.text += line;
+        text.text += '\n';
+    }
+
+    if (!text.text.empty())
+        chunk.segments.push_back(std::move(text));
+
+    return chunk;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ShaderPreprocessor::expandInto(const std::string& file, PreprocessedSource& out, std::unordered_set<std::string>& included, const int depth) {
+    if (depth > MAX_INCLUDE_DEPTH) {
+        out.code += "#error #include nested too deeply, is there a cycle without #pragma once?\n";
+        return;
+    }
+
+    const Chunk& chunk = load(file);
+
+    if (chunk.once && !included.insert(file).second)
+        return;
+
+    const auto known = std::find(out.files.begin(), out.files.end(), file);
+    const std::size_t fileIndex = static_cast<std::size_t>(known - out.files.begin());
+    if (known == out.files.end())
+        out.files.push_back(file);
+
+    if (!chunk.found) {
+        out.code += "#error cannot open \"" + file + "\"\n";
+        return;
+    }
+
+    for (const Segment& segment : chunk.segments) {
+        if (!segment.include.empty()) {
+            expandInto(segment.include, out, included, depth + 1);
+            continue;
+        }
+
+        // #line may not precede #version, so the very first text of the root file goes in untouched
+        if (!out.code.empty())
+            out.code += "#line " + std::to_string(segment.line) + " " + std::to_string(fileIndex) + "\n";
+        out.code += segment.text;
+    }
+}
@@ -0,0 +1,161 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "shader_stage.h"
+
+#include <iostream>
+#include <utility>
+
+#include "gl_state.h"
+#include "program_cache.h"
+
+namespace {
+    const char* stageName(const GLenum type) {
+        switch (type) {
+            case GL_VERTEX_SHADER: return "VERTEX";
+            case GL_FRAGMENT_SHADER: return "FRAGMENT";
+            case GL_GEOMETRY_SHADER: return "GEOMETRY";
+            case GL_COMPUTE_SHADER: return "COMPUTE";
+            default: return "UNKNOWN";
+        }
+    }
+}
+
+std::shared_ptr<ShaderStage> ShaderStage::get(const GLenum type, PreprocessedSource source) {
+    // the stage type is part of the key, a file could in theory be valid as more than one stage
+    const std::uint64_t key = ProgramBinaryCache::makeKey({stageName(type), source.code});
+
+    if (const auto it = stages.find(key); it != stages.end()) {
+        if (std::shared_ptr<ShaderStage> stage = it->second.lock())
+            return stage;
+    }
+
+    auto stage = std::make_shared<ShaderStage>(type, std::move(source), key);
+    stages[key] = stage;
+    return stage;
+}
+
+bool ShaderStage::enableParallelCompile() {
+    // 0xFFFFFFFF lets the implementation pick the number of compiler threads
+    if (GLAD_GL_KHR_parallel_shader_compile)
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    else if (GLAD_GL_ARB_parallel_shader_compile)
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+
+    parallelCompile = GLAD_GL_KHR_parallel_shader_compile || GLAD_GL_ARB_parallel_shader_compile;
+    return parallelCompile;
+}
+
+std::size_t ShaderStage::getLiveCount() {
+    std::erase_if(stages, [](const auto& entry) { return entry.second.expired(); });
+    return stages.size();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+ShaderStage::ShaderStage(const GLenum type, PreprocessedSource source, const std::uint64_t cacheKey) :
+type(type), cacheKey(cacheKey), files(std::move(source.files)) {
+    program = glCreateProgram();
+    glProgramParameteri(program, GL_PROGRAM_SEPARABLE, GL_TRUE);
+
+    // 1. reuse a cached program binary when the source and the driver are unchanged
+    if (ProgramBinaryCache::load(program, cacheKey)) {
+        uniforms.build(program);
+        status = ShaderStatus::Ready;
+        return;
+    }
+
+    // 2. hand the compile and the link to the driver without querying any status in between
+    buildStart = std::chrono::steady_clock::now();
+
+    const char* code = source.code.c_str();
+    pendingShader = glCreateShader(type);
+    glShaderSource(pendingShader, 1, &code, nullptr);
+    glCompileShader(pendingShader);
+
+    // link, asking the driver to keep the binary around for the cache
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glAttachShader(program, pendingShader);
+    glLinkProgram(program);
+}
+
+ShaderStage::~ShaderStage() {
+    if (pendingShader)
+        glDeleteShader(pendingShader);
+    GLState::forgetProgram(program);
+    glDeleteProgram(program);
+}
+
+ShaderStatus ShaderStage::poll() {
+    if (status != ShaderStatus::Pending)
+        return status;
+
+    // without the extension any status query blocks anyway, so just finish the build
+    if (parallelCompile) {
+        GLint completed = GL_FALSE;
+        glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &completed);
+        if (!completed)
+            return ShaderStatus::Pending;
+    }
+
+    finishBuild();
+    return status;
+}
+
+void ShaderStage::wait() {
+    if (status == ShaderStatus::Pending)
+        finishBuild();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ShaderStage::finishBuild() {
+    // the status queries below are what actually waits for the driver
+    bool success = checkCompileErrors(pendingShader, stageName(type), &files);
+    success &= checkCompileErrors(program, "PROGRAM");
+
+    // delete the shader; already linked to program
+    glDetachShader(program, pendingShader);
+    glDeleteShader(pendingShader);
+    pendingShader = 0;
+
+    if (!success) {
+        status = ShaderStatus::Failed;
+        return;
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    ProgramBinaryCache::store(program, cacheKey, std::chrono::duration<double, std::milli>(end - buildStart).count());
+
+    // resolve every active uniform once, setters only look locations up from here on
+    uniforms.build(program);
+    status = ShaderStatus::Ready;
+}
+
+bool ShaderStage::checkCompileErrors(const GLuint object, const char* type, const std::vector<std::string>* files) {
+    GLint success;
+    GLchar info[1024];
+    if (std::string_view(type) != "PROGRAM") {
+        glGetShaderiv(object, GL_COMPILE_STATUS, &success);
+        if (!success) {
+            glGetShaderInfoLog(object, 1024, nullptr, info);
+            std::cerr << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << info << "\n";
+
+            // errors are reported as <source string>(<line>); list which file each source string is
+            if (files) {
+                for (std::size_t i = 0; i < files->size(); i++)
+                    std::cerr << "  " << i << ": " << (*files)[i] << "\n";
+            }
+            std::cerr << " -- -------------------------------------- --\n";
+        }
+    }
+    else {
+        glGetProgramiv(object, GL_LINK_STATUS, &success);
+        if (!success) {
+            glGetProgramInfoLog(object, 1024, nullptr, info);
+            std::cerr << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << info << "\n -- ----------------------------------------- --\n";
+        }
+    }
+    return success;
+}
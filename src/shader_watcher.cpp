@@ -0,0 +1,195 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "shader_watcher.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+#include "shader_preprocessor.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+ShaderWatcher::ShaderWatcher() {
+#ifdef __linux__
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (inotifyFd < 0 || wakeFd < 0) {
+        std::cerr << "ERROR::SHADER_WATCHER::INOTIFY_UNAVAILABLE hot-reload disabled" << std::endl;
+        return;
+    }
+    thread = std::thread(&ShaderWatcher::run, this);
+#endif
+}
+
+ShaderWatcher::~ShaderWatcher() {
+#ifdef __linux__
+    if (thread.joinable()) {
+        // wake the watcher thread out of poll() so it can exit
+        constexpr std::uint64_t one = 1;
+        [[maybe_unused]] const auto written = write(wakeFd, &one, sizeof(one));
+        thread.join();
+    }
+    if (inotifyFd >= 0)
+        close(inotifyFd);
+    if (wakeFd >= 0)
+        close(wakeFd);
+#endif
+}
+
+void ShaderWatcher::watch(Shader& shader) {
+    for (const std::string& dependency : shader.getDependencies()) {
+        const std::string file = ShaderPreprocessor::canonicalPath(dependency);
+
+        auto& shaders = dependents[file];
+        if (std::find(shaders.begin(), shaders.end(), &shader) == shaders.end())
+            shaders.push_back(&shader);
+
+        addWatch(watchedPathFor(file));
+    }
+}
+
+void ShaderWatcher::unwatch(const Shader& shader) {
+    for (auto& [file, shaders] : dependents)
+        std::erase(shaders, &shader);
+}
+
+/** Rebuild every program whose sources changed since the last call */
+unsigned int ShaderWatcher::poll() {
+    // the common case: nothing changed, a single relaxed load and no locking
+    if (!changed.load(std::memory_order_relaxed))
+        return 0;
+
+    std::unordered_set<std::string> files;
+    {
+        std::lock_guard lock(mutex);
+        files.swap(changedFiles);
+        changed.store(false, std::memory_order_relaxed);
+    }
+
+    // a program that includes several changed files is still rebuilt only once; dependents holds the include
+    // graph flattened per file, so a header edit reaches exactly the programs that pull it in
+    std::vector<Shader*> affected;
+    for (std::string file : files) {
+        // an edit in the source tree is copied over the build copy the program was loaded from, as the build would
+        if (const auto copy = copies.find(file); copy != copies.end()) {
+            std::error_code error;
+            std::filesystem::copy_file(copy->first, copy->second, std::filesystem::copy_options::overwrite_existing, error);
+            if (error) {
+                std::cerr << "ERROR::SHADER_WATCHER::COPY_FAILED " << copy->first << " " << error.message() << std::endl;
+                continue;
+            }
+            file = copy->second;
+        }
+
+        // only the edited file is read again, every other memoized file stays as it is
+        ShaderPreprocessor::invalidate(file);
+
+        const auto it = dependents.find(file);
+        if (it == dependents.end())
+            continue;
+
+        for (Shader* shader : it->second) {
+            if (std::find(affected.begin(), affected.end(), shader) == affected.end())
+                affected.push_back(shader);
+        }
+    }
+
+    unsigned int reloaded = 0;
+    for (Shader* shader : affected) {
+        if (shader->reload()) {
+            reloaded++;
+
+            // the rebuilt program may depend on a different set of files now
+            watch(*shader);
+        }
+    }
+    return reloaded;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** The file in the source tree that file was copied from by the build, or file itself when there is none */
+std::string ShaderWatcher::watchedPathFor(const std::string& file) {
+#if defined(RESOURCE_SOURCE_DIR) && defined(RESOURCE_DEST_DIR)
+    static const std::filesystem::path buildRoot = ShaderPreprocessor::canonicalPath(RESOURCE_DEST_DIR);
+
+    const std::filesystem::path relative = std::filesystem::path(file).lexically_relative(buildRoot);
+    if (relative.empty() || *relative.begin() == "..")
+        return file;
+
+    std::string source = ShaderPreprocessor::canonicalPath((std::filesystem::path(RESOURCE_SOURCE_DIR) / relative).string());
+    std::error_code error;
+    if (source == file || !std::filesystem::exists(source, error))
+        return file;
+
+    copies[source] = file;
+    return source;
+#else
+    return file;
+#endif
+}
+
+void ShaderWatcher::addWatch(const std::string& file) {
+    std::lock_guard lock(mutex);
+    if (!watchedFiles.insert(file).second)
+        return;
+
+#ifdef __linux__
+    if (inotifyFd < 0)
+        return;
+
+    const std::string directory = std::filesystem::path(file).parent_path().string();
+    const int wd = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0) {
+        std::cerr << "ERROR::SHADER_WATCHER::WATCH_FAILED " << directory << std::endl;
+        return;
+    }
+    watchedDirectories[wd] = directory;
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void ShaderWatcher::run() {
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+
+    while (true) {
+        pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        if (::poll(fds, 2, -1) < 0)
+            continue;
+
+        // destructor asked us to stop
+        if (fds[1].revents & POLLIN)
+            return;
+
+        const ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0)
+            continue;
+
+        std::lock_guard lock(mutex);
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            const auto directory = watchedDirectories.find(event->wd);
+            if (directory == watchedDirectories.end() || event->len == 0)
+                continue;
+
+            std::string file = (std::filesystem::path(directory->second) / event->name).string();
+            if (watchedFiles.contains(file)) {
+                changedFiles.insert(std::move(file));
+                changed.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+#endif
+}
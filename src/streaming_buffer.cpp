@@ -0,0 +1,96 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "streaming_buffer.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // every GL offset alignment (uniform, storage, attribute) is at most this, so regions start on one
+    constexpr GLsizeiptr REGION_ALIGNMENT = 256;
+
+    constexpr GLbitfield STREAM_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+}
+
+StreamingBuffer::StreamingBuffer(const GLsizeiptr regionSize, const std::size_t regionCount) : fences(regionCount, nullptr) {
+    create(regionSize);
+}
+
+StreamingBuffer::~StreamingBuffer() {
+    for (const GLsync fence : fences) {
+        if (fence)
+            glDeleteSync(fence);
+    }
+}
+
+void StreamingBuffer::create(const GLsizeiptr size) {
+    regionSize = (size + REGION_ALIGNMENT - 1) / REGION_ALIGNMENT * REGION_ALIGNMENT;
+    buffer = Buffer(regionSize * static_cast<GLsizeiptr>(fences.size()), nullptr, STREAM_FLAGS);
+    mapping = static_cast<std::byte*>(buffer.map(STREAM_FLAGS));
+    if (!mapping)
+        std::cerr << "ERROR::STREAMING_BUFFER::MAP_FAILED" << std::endl;
+
+    region = 0;
+    used = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void StreamingBuffer::beginFrame() {
+    // everything reading the current region has been submitted by now
+    if (used > 0) {
+        fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        region = (region + 1) % fences.size();
+        used = 0;
+    }
+    waitForRegion(region);
+}
+
+void StreamingBuffer::waitForRegion(const std::size_t index) {
+    const GLsync fence = fences[index];
+    if (!fence)
+        return;
+
+    // poll first, so a region the GPU is already done with doesn't count as a stall
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED) {
+        stalls++;
+        do {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+        } while (result == GL_TIMEOUT_EXPIRED);
+    }
+    if (result == GL_WAIT_FAILED)
+        std::cerr << "ERROR::STREAMING_BUFFER::WAIT_FAILED" << std::endl;
+
+    glDeleteSync(fence);
+    fences[index] = nullptr;
+}
+
+void StreamingBuffer::reserve(const GLsizeiptr size) {
+    if (size <= regionSize)
+        return;
+
+    // the old buffer goes away with its mapping, so nothing may still be reading any of it
+    for (std::size_t index = 0; index < fences.size(); index++)
+        waitForRegion(index);
+
+    GLsizeiptr grown = std::max(regionSize, REGION_ALIGNMENT);
+    while (grown < size)
+        grown *= 2;
+    create(grown);
+}
+
+StreamAllocation StreamingBuffer::allocate(const GLsizeiptr size, const GLsizeiptr alignment) {
+    const GLsizeiptr offset = (used + alignment - 1) & ~(alignment - 1);
+    if (!mapping || offset + size > regionSize) {
+        std::cerr << "ERROR::STREAMING_BUFFER::OUT_OF_SPACE " << size << " bytes requested, "
+                  << regionSize - used << " left in the region" << std::endl;
+        return {};
+    }
+
+    used = offset + size;
+    const GLintptr start = static_cast<GLintptr>(region) * regionSize + offset;
+    return {mapping + start, start, size};
+}
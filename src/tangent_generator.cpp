@@ -0,0 +1,114 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "tangent_generator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    /** Unit direction of +u across one triangle, and whether the UV mapping keeps the winding (1) or mirrors it (-1) */
+    struct TriangleFrame {
+        glm::vec3 tangent{0.0f};
+        // 0 when the texture coordinates are degenerate and the triangle has no say
+        float orientation = 0.0f;
+    };
+
+    /** Any unit vector perpendicular to normal, for vertices none of whose triangles define a tangent */
+    glm::vec3 perpendicular(const glm::vec3& normal) {
+        const glm::vec3 axis = std::abs(normal.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        const glm::vec3 tangent = axis - normal * glm::dot(normal, axis);
+        const float length = glm::length(tangent);
+        return length > 0.0f ? tangent / length : glm::vec3(1.0f, 0.0f, 0.0f);
+    }
+}
+
+std::vector<glm::vec4> generateTangents(const std::span<const Vertex> vertices, const std::span<const std::uint32_t> indices,
+                                        ThreadPool& pool) {
+    const std::size_t triangleCount = indices.size() / 3;
+    const std::size_t vertexCount = vertices.size();
+
+    // texture-space frame of every triangle
+    std::vector<TriangleFrame> frames(triangleCount);
+    pool.parallelFor(triangleCount, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t triangle = begin; triangle < end; triangle++) {
+            const Vertex& v0 = vertices[indices[triangle * 3]];
+            const Vertex& v1 = vertices[indices[triangle * 3 + 1]];
+            const Vertex& v2 = vertices[indices[triangle * 3 + 2]];
+
+            const glm::vec3 d1 = v1.position - v0.position;
+            const glm::vec3 d2 = v2.position - v0.position;
+            const glm::vec2 t21 = v1.texCoords - v0.texCoords;
+            const glm::vec2 t31 = v2.texCoords - v0.texCoords;
+
+            const float signedArea = t21.x * t31.y - t21.y * t31.x;
+            const glm::vec3 tangent = t31.y * d1 - t21.y * d2;
+            const float length = glm::length(tangent);
+            if (signedArea == 0.0f || length <= 0.0f)
+                continue;
+
+            const float orientation = signedArea > 0.0f ? 1.0f : -1.0f;
+            frames[triangle] = {orientation / length * tangent, orientation};
+        }
+    });
+
+    // triangles around each vertex in ascending order, which fixes the order of every sum below
+    std::vector<std::uint32_t> adjacencyStart(vertexCount + 1, 0), adjacency(triangleCount * 3);
+    for (std::size_t index = 0; index < triangleCount * 3; index++)
+        adjacencyStart[indices[index] + 1]++;
+    for (std::size_t vertex = 0; vertex < vertexCount; vertex++)
+        adjacencyStart[vertex + 1] += adjacencyStart[vertex];
+    {
+        std::vector<std::uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+        for (std::size_t index = 0; index < triangleCount * 3; index++)
+            adjacency[fill[indices[index]]++] = static_cast<std::uint32_t>(index);
+    }
+
+    std::vector<glm::vec4> tangents(vertexCount);
+    pool.parallelFor(vertexCount, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t vertex = begin; vertex < end; vertex++) {
+            // a zero normal (a zero vn, or only degenerate faces) has no tangent plane; normalizing it would spread NaN
+            const float normalLength = glm::length(vertices[vertex].normal);
+            if (!(normalLength > 0.0f)) {
+                tangents[vertex] = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+                continue;
+            }
+            const glm::vec3 normal = vertices[vertex].normal / normalLength;
+            glm::vec3 sum(0.0f);
+            float orientation = 0.0f;
+
+            for (std::uint32_t entry = adjacencyStart[vertex]; entry < adjacencyStart[vertex + 1]; entry++) {
+                const std::uint32_t corner = adjacency[entry];
+                const std::size_t triangle = corner / 3;
+                const TriangleFrame& frame = frames[triangle];
+                if (frame.orientation == 0.0f)
+                    continue;
+
+                // projected onto the tangent plane of this vertex's normal, weighted by the angle of its corner
+                glm::vec3 projected = frame.tangent - normal * glm::dot(normal, frame.tangent);
+                const float projectedLength = glm::length(projected);
+                if (projectedLength <= 0.0f)
+                    continue;
+                projected /= projectedLength;
+
+                const glm::vec3 position = vertices[vertex].position;
+                const std::uint32_t local = corner % 3;
+                const glm::vec3 toNext = vertices[indices[triangle * 3 + (local + 1) % 3]].position - position;
+                const glm::vec3 toPrevious = vertices[indices[triangle * 3 + (local + 2) % 3]].position - position;
+                const float lengths = glm::length(toNext) * glm::length(toPrevious);
+                if (lengths <= 0.0f)
+                    continue;
+                const float angle = std::acos(std::clamp(glm::dot(toNext, toPrevious) / lengths, -1.0f, 1.0f));
+
+                sum += angle * projected;
+                orientation += angle * frame.orientation;
+            }
+
+            const float length = glm::length(sum);
+            const glm::vec3 tangent = length > 0.0f ? sum / length : perpendicular(normal);
+            tangents[vertex] = glm::vec4(tangent, orientation < 0.0f ? -1.0f : 1.0f);
+        }
+    });
+    return tangents;
+}
@@ -0,0 +1,61 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "thread_pool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(std::size_t threadCount) {
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    workers.reserve(threadCount);
+    for (std::size_t index = 0; index < threadCount; index++)
+        workers.emplace_back(&ThreadPool::run, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+void ThreadPool::run() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(mutex);
+            wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+            // queued jobs still run on shutdown, someone may be waiting on their futures
+            if (jobs.empty())
+                return;
+            job = std::move(jobs.front());
+            jobs.pop();
+        }
+        job();
+    }
+}
+
+void ThreadPool::parallelFor(const std::size_t count, const std::function<void(std::size_t, std::size_t)>& job) {
+    if (count == 0)
+        return;
+
+    // a few batches per worker even out uneven ones without queueing an entry per index
+    const std::size_t batches = std::min(count, workers.size() * 4);
+    std::vector<std::future<void>> pending;
+    pending.reserve(batches);
+    for (std::size_t batch = 0; batch < batches; batch++) {
+        const std::size_t begin = count * batch / batches;
+        const std::size_t end = count * (batch + 1) / batches;
+        pending.push_back(submit([&job, begin, end] { job(begin, end); }));
+    }
+
+    // get() rather than wait() so an exception thrown by a batch reaches the caller
+    for (std::future<void>& future : pending)
+        future.get();
+}
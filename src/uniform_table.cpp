@@ -0,0 +1,134 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "uniform_table.h"
+
+#include <algorithm>
+#include <bit>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+
+void UniformTable::build(const GLuint program) {
+    clear();
+
+    GLint activeCount = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &activeCount);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    // 1. gather every addressable name first, so the slot array is sized exactly once
+    struct Pending {
+        std::string name;
+        GLint location;
+        GLenum type;
+    };
+    std::vector<Pending> pending;
+    pending.reserve(static_cast<std::size_t>(activeCount));
+
+    std::string buffer(static_cast<std::size_t>(maxLength), '\0');
+    for (GLint i = 0; i < activeCount; i++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = GL_NONE;
+        glGetActiveUniform(program, static_cast<GLuint>(i), maxLength, &length, &size, &type, buffer.data());
+
+        std::string uniformName(buffer.data(), static_cast<std::size_t>(length));
+        const GLint location = glGetUniformLocation(program, uniformName.c_str());
+
+        // members of uniform blocks have no location, they are fed through buffers instead
+        if (location < 0)
+            continue;
+
+        // arrays are reported as "name[0]"; make "name" and every "name[i]" addressable as well
+        if (uniformName.ends_with("[0]")) {
+            const std::string base = uniformName.substr(0, uniformName.size() - 3);
+            pending.push_back({base, location, type});
+
+            for (GLint element = 1; element < size; element++) {
+                std::string elementName = base + "[" + std::to_string(element) + "]";
+                const GLint elementLocation = glGetUniformLocation(program, elementName.c_str());
+                pending.push_back({std::move(elementName), elementLocation, type});
+            }
+        }
+
+        pending.push_back({std::move(uniformName), location, type});
+    }
+
+    // 2. keep the load factor at or below 50% so probe sequences stay short
+    const std::size_t capacity = std::bit_ceil(std::max<std::size_t>(8, pending.size() * 2));
+    slots.assign(capacity, UniformInfo{});
+
+    // 3. one shadow per distinct location; nothing has been uploaded yet, so every shadow starts out invalid
+    std::unordered_map<GLint, std::uint32_t> shadowIndices;
+    for (const auto& [name, location, type] : pending) {
+        const auto [it, inserted] = shadowIndices.try_emplace(location, static_cast<std::uint32_t>(shadowIndices.size()));
+        insert(name, location, type, it->second);
+    }
+
+    shadow.assign(shadowIndices.size() * SHADOW_STRIDE, std::byte{0});
+    shadowValid.assign(shadowIndices.size(), false);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void UniformTable::clear() {
+    slots.clear();
+    names.clear();
+    shadow.clear();
+    shadowValid.clear();
+    count = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+const UniformInfo* UniformTable::find(const std::string_view name) const {
+    return find(hashString(name), name);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+const UniformInfo* UniformTable::find(const std::uint64_t hash, const std::string_view name) const {
+    if (slots.empty())
+        return nullptr;
+
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+        const UniformInfo& slot = slots[i];
+
+        // an empty slot ends the probe sequence
+        if (slot.nameLength == 0)
+            return nullptr;
+        if (slot.hash == hash && this->name(slot) == name)
+            return &slot;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void UniformTable::insert(const std::string_view name, const GLint location, const GLenum type, const std::uint32_t shadowIndex) {
+    const std::uint64_t hash = hashString(name);
+    const std::size_t mask = slots.size() - 1;
+
+    std::size_t i = hash & mask;
+    while (slots[i].nameLength != 0) {
+        // the same name can be reported twice for single-element arrays; keep the first
+        if (slots[i].hash == hash && this->name(slots[i]) == name)
+            return;
+        i = (i + 1) & mask;
+    }
+
+    slots[i] = UniformInfo{
+        hash,
+        location,
+        type,
+        static_cast<std::uint32_t>(names.size()),
+        static_cast<std::uint32_t>(name.size()),
+        shadowIndex
+    };
+    names.append(name);
+    count++;
+}
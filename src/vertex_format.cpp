@@ -0,0 +1,207 @@
+//
+// Created by niek on 10/17/2026.
+//
+
+#include "vertex_format.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <glm/gtc/packing.hpp>
+
+#include "gl_objects.h"
+
+namespace {
+    /** Normal folded onto the octahedron |x| + |y| + |z| = 1, lower half mirrored over the diagonals */
+    glm::vec2 octahedralEncode(glm::vec3 normal) {
+        normal /= std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+        glm::vec2 folded(normal.x, normal.y);
+        if (normal.z < 0.0f) {
+            const glm::vec2 sign(folded.x >= 0.0f ? 1.0f : -1.0f, folded.y >= 0.0f ? 1.0f : -1.0f);
+            folded = (1.0f - glm::abs(glm::vec2(folded.y, folded.x))) * sign;
+        }
+        return folded;
+    }
+
+    std::uint32_t packSnorm10(const float value) {
+        const auto quantized = static_cast<std::int32_t>(std::round(std::clamp(value, -1.0f, 1.0f) * 511.0f));
+        return static_cast<std::uint32_t>(quantized) & 0x3FFu;
+    }
+
+    template<typename T>
+    std::byte* write(std::byte* out, const T& value) {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    }
+}
+
+// VertexFormat
+// ---------------------------------------------------------------------------------------------------------------------
+std::uint32_t VertexFormat::positionSize() const {
+    // three shorts padded to four keep the next attribute 4-byte aligned
+    return position == PositionFormat::Float ? 3 * sizeof(float) : 4 * sizeof(std::int16_t);
+}
+
+std::uint32_t VertexFormat::normalSize() const {
+    return normal == NormalFormat::Float ? 3 * sizeof(float) : sizeof(std::uint32_t);
+}
+
+std::uint32_t VertexFormat::texCoordSize() const {
+    return texCoords == TexCoordFormat::Float ? 2 * sizeof(float) : 2 * sizeof(std::uint16_t);
+}
+
+std::uint32_t VertexFormat::tangentSize() const {
+    switch (tangent) {
+        case TangentFormat::None: return 0;
+        case TangentFormat::Float: return 4 * sizeof(float);
+        case TangentFormat::Int2_10_10_10: return sizeof(std::uint32_t);
+    }
+    return 0;
+}
+
+std::uint32_t VertexFormat::key() const {
+    return static_cast<std::uint32_t>(position) | static_cast<std::uint32_t>(normal) << 8 |
+           static_cast<std::uint32_t>(texCoords) << 16 | static_cast<std::uint32_t>(tangent) << 24;
+}
+
+void VertexFormat::applyLayout(const VertexArray& vertexArray) const {
+    const std::uint32_t normalOffset = positionSize();
+    const std::uint32_t texCoordOffset = normalOffset + normalSize();
+    const std::uint32_t tangentOffset = texCoordOffset + texCoordSize();
+
+    if (position == PositionFormat::Float)
+        vertexArray.attribute(0, 0, 3, GL_FLOAT, 0);
+    else
+        vertexArray.attribute(0, 0, 3, GL_SHORT, 0, true);
+
+    switch (normal) {
+        case NormalFormat::Float:
+            vertexArray.attribute(1, 0, 3, GL_FLOAT, normalOffset);
+            break;
+        case NormalFormat::Int2_10_10_10:
+            // packed types always have four components; the shader's vec3 input drops w
+            vertexArray.attribute(1, 0, 4, GL_INT_2_10_10_10_REV, normalOffset, true);
+            break;
+        case NormalFormat::Octahedral:
+            vertexArray.attribute(1, 0, 2, GL_SHORT, normalOffset, true);
+            break;
+    }
+
+    switch (texCoords) {
+        case TexCoordFormat::Float:
+            vertexArray.attribute(2, 0, 2, GL_FLOAT, texCoordOffset);
+            break;
+        case TexCoordFormat::Half:
+            vertexArray.attribute(2, 0, 2, GL_HALF_FLOAT, texCoordOffset);
+            break;
+        case TexCoordFormat::Unorm16:
+            vertexArray.attribute(2, 0, 2, GL_UNSIGNED_SHORT, texCoordOffset, true);
+            break;
+    }
+
+    switch (tangent) {
+        case TangentFormat::None:
+            break;
+        case TangentFormat::Float:
+            vertexArray.attribute(5, 0, 4, GL_FLOAT, tangentOffset);
+            break;
+        case TangentFormat::Int2_10_10_10:
+            vertexArray.attribute(5, 0, 4, GL_INT_2_10_10_10_REV, tangentOffset, true);
+            break;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+VertexQuantization encodeVertices(std::span<const Vertex> vertices, const VertexFormat format, std::vector<std::byte>& out,
+                                  const std::span<const glm::vec4> tangents) {
+    VertexQuantization quantization;
+    if (format.position == PositionFormat::Snorm16 && !vertices.empty()) {
+        glm::vec3 min = vertices.front().position;
+        glm::vec3 max = min;
+        for (const Vertex& vertex : vertices) {
+            min = glm::min(min, vertex.position);
+            max = glm::max(max, vertex.position);
+        }
+        quantization.positionOffset = 0.5f * (min + max);
+        quantization.positionScale = 0.5f * (max - min);
+        // a flat axis (the plane's Y) stores zeros whatever its scale, 1 just avoids dividing by zero
+        for (int axis = 0; axis < 3; axis++)
+            if (quantization.positionScale[axis] <= 0.0f)
+                quantization.positionScale[axis] = 1.0f;
+    }
+
+    const std::size_t first = out.size();
+    out.resize(first + vertices.size() * format.stride());
+    std::byte* cursor = out.data() + first;
+
+    for (std::size_t index = 0; index < vertices.size(); index++) {
+        const Vertex& vertex = vertices[index];
+        if (format.position == PositionFormat::Float) {
+            cursor = write(cursor, vertex.position);
+        }
+        else {
+            const glm::vec3 local = (vertex.position - quantization.positionOffset) / quantization.positionScale;
+            for (int axis = 0; axis < 3; axis++)
+                cursor = write(cursor, static_cast<std::int16_t>(glm::packSnorm1x16(local[axis])));
+            cursor = write(cursor, std::int16_t{0});
+        }
+
+        switch (format.normal) {
+            case NormalFormat::Float:
+                cursor = write(cursor, vertex.normal);
+                break;
+            case NormalFormat::Int2_10_10_10:
+                cursor = write(cursor, packSnorm10(vertex.normal.x) | packSnorm10(vertex.normal.y) << 10 |
+                                       packSnorm10(vertex.normal.z) << 20);
+                break;
+            case NormalFormat::Octahedral: {
+                const glm::vec2 folded = octahedralEncode(vertex.normal);
+                cursor = write(cursor, glm::packSnorm1x16(folded.x));
+                cursor = write(cursor, glm::packSnorm1x16(folded.y));
+                break;
+            }
+        }
+
+        switch (format.texCoords) {
+            case TexCoordFormat::Float:
+                cursor = write(cursor, vertex.texCoords);
+                break;
+            case TexCoordFormat::Half:
+                cursor = write(cursor, glm::packHalf1x16(vertex.texCoords.x));
+                cursor = write(cursor, glm::packHalf1x16(vertex.texCoords.y));
+                break;
+            case TexCoordFormat::Unorm16:
+                cursor = write(cursor, glm::packUnorm1x16(vertex.texCoords.x));
+                cursor = write(cursor, glm::packUnorm1x16(vertex.texCoords.y));
+                break;
+        }
+
+        if (format.tangent == TangentFormat::None)
+            continue;
+        const glm::vec4 tangent = index < tangents.size() ? tangents[index] : glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+        if (format.tangent == TangentFormat::Float) {
+            cursor = write(cursor, tangent);
+        } else {
+            // a 2-bit signed normalized w holds exactly -1 (0b11) and 1 (0b01)
+            const std::uint32_t sign = tangent.w < 0.0f ? 3u : 1u;
+            cursor = write(cursor, packSnorm10(tangent.x) | packSnorm10(tangent.y) << 10 | packSnorm10(tangent.z) << 20 | sign << 30);
+        }
+    }
+
+    return quantization;
+}
+
+// InstanceTransform
+// ---------------------------------------------------------------------------------------------------------------------
+InstanceTransform InstanceTransform::from(const glm::vec3 translation, const glm::quat& rotation, const float scale) {
+    const glm::quat unit = glm::normalize(rotation);
+    return {glm::vec4(translation, scale), glm::vec4(unit.x, unit.y, unit.z, unit.w)};
+}
+
+void InstanceTransform::applyLayout(const VertexArray& vertexArray, const GLuint binding) {
+    vertexArray.attribute(3, binding, 4, GL_FLOAT, offsetof(InstanceTransform, translationScale));
+    vertexArray.attribute(4, binding, 4, GL_FLOAT, offsetof(InstanceTransform, rotation));
+    vertexArray.bindingDivisor(binding, 1);
+}